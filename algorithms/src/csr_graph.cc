@@ -0,0 +1,61 @@
+#include "csr_graph.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+CsrGraph::CsrGraph(const V_GraphEdge& edges) {
+  auto intern = [this](const std::string& name) {
+    auto inserted = ids_.emplace(name, static_cast<NodeId>(names_.size()));
+    if (inserted.second) {
+      names_.push_back(name);
+    }
+    return inserted.first->second;
+  };
+
+  // Endpoints of each input edge, interned once.
+  std::vector<NodeId> lefts, rights;
+  lefts.reserve(edges.size());
+  rights.reserve(edges.size());
+  for (const auto& edge : edges) {
+    lefts.push_back(intern(edge.left));
+    rights.push_back(intern(edge.right));
+  }
+
+  // Counting sort by source node. Each input edge adds both directions.
+  offsets_.assign(names_.size() + 1, 0);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    ++offsets_[lefts[i] + 1];
+    ++offsets_[rights[i] + 1];
+  }
+  for (size_t i = 1; i < offsets_.size(); ++i) {
+    offsets_[i] += offsets_[i - 1];
+  }
+
+  edges_.resize(2 * edges.size());
+  std::vector<uint32_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edges_[next[lefts[i]]++] = {rights[i], edges[i].cost};
+    edges_[next[rights[i]]++] = {lefts[i], 1.0 / edges[i].cost};
+  }
+}
+
+std::optional<NodeId> CsrGraph::findNode(const std::string& name) const {
+  auto iter = ids_.find(name);
+  if (iter == ids_.end()) {
+    return std::nullopt;
+  }
+  return iter->second;
+}
+
+LogCsrGraph::LogCsrGraph(const CsrGraph& graph) {
+  offsets_.reserve(graph.getNumNodes() + 1);
+  edges_.reserve(graph.getNumEdges());
+  offsets_.push_back(0);
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    for (const auto& [target, cost] : graph.getConnections(node)) {
+      edges_.push_back({target, LogCost{std::log(cost)}});
+    }
+    offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+  }
+}
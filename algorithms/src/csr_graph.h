@@ -0,0 +1,116 @@
+#ifndef INTERVIEW_PRACTICE_CSR_GRAPH_H_
+#define INTERVIEW_PRACTICE_CSR_GRAPH_H_
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "log_ratio.h"
+
+// Each graph edge gives the cost from left->right.
+// Cost from right->left is the multiplicative inverse (1.0 / COST).
+struct GraphEdge {
+  std::string left;
+  std::string right;
+  double cost;
+};
+
+using V_GraphEdge = std::vector<GraphEdge>;
+
+// Interned node ID: index into the graph's node arrays.
+using NodeId = uint32_t;
+
+// Outgoing edge of a CsrGraph node.
+struct CsrEdge {
+  NodeId target;
+  double cost;
+};
+
+// Outgoing edge of a LogCsrGraph node.
+struct LogCsrEdge {
+  NodeId target;
+  LogCost cost;
+};
+
+// Read-only view of a node's edges, pointing into the graph.
+template <typename Edge>
+class BasicEdgeSpan {
+ public:
+  BasicEdgeSpan(Edge const *begin, Edge const *end)
+      : begin_(begin), end_(end) {}
+
+  Edge const *begin() const { return begin_; }
+  Edge const *end() const { return end_; }
+  size_t size() const { return static_cast<size_t>(end_ - begin_); }
+  bool empty() const { return begin_ == end_; }
+
+ private:
+  Edge const *begin_;
+  Edge const *end_;
+};
+
+using EdgeSpan = BasicEdgeSpan<CsrEdge>;
+
+// Compressed sparse row graph. Node names are interned to dense IDs (in order
+// of first appearance in the edges), and each node's edges are contiguous in
+// one array, in the same order as the input edges.
+//
+// Immutable once built.
+class CsrGraph {
+ public:
+  using Node = NodeId;
+  static constexpr bool kDenseNodeIds = true;
+
+  explicit CsrGraph(const V_GraphEdge& edges);
+
+  size_t getNumNodes() const { return names_.size(); }
+  size_t getNumEdges() const { return edges_.size(); }
+
+  // ID for name, or nullopt if the name isn't in the graph.
+  std::optional<NodeId> findNode(const std::string& name) const;
+
+  const std::string& getName(NodeId node) const { return names_[node]; }
+
+  // Edges from node. Valid as long as the graph is.
+  EdgeSpan getConnections(NodeId node) const {
+    return EdgeSpan(edges_.data() + offsets_[node],
+                    edges_.data() + offsets_[node + 1]);
+  }
+
+ private:
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, NodeId> ids_;
+
+  // Edges of node i are edges_[offsets_[i] .. offsets_[i + 1]).
+  std::vector<uint32_t> offsets_;
+  std::vector<CsrEdge> edges_;
+};
+
+// A CsrGraph's edges with the natural log of each cost, taken once when built.
+// Log-space searches (findLogCost, FindRootsAndBaseLogRatios) over it add
+// these logs, instead of taking a std::log per edge they cross. Same node IDs
+// and edge order as the CsrGraph.
+class LogCsrGraph {
+ public:
+  using Node = NodeId;
+  static constexpr bool kDenseNodeIds = true;
+
+  explicit LogCsrGraph(const CsrGraph& graph);
+
+  size_t getNumNodes() const { return offsets_.size() - 1; }
+
+  // Edges from node. Valid as long as the graph is.
+  BasicEdgeSpan<LogCsrEdge> getConnections(NodeId node) const {
+    return BasicEdgeSpan<LogCsrEdge>(edges_.data() + offsets_[node],
+                                     edges_.data() + offsets_[node + 1]);
+  }
+
+ private:
+  // Edges of node i are edges_[offsets_[i] .. offsets_[i + 1]).
+  std::vector<uint32_t> offsets_;
+  std::vector<LogCsrEdge> edges_;
+};
+
+#endif  // INTERVIEW_PRACTICE_CSR_GRAPH_H_
@@ -0,0 +1,65 @@
+#include "csr_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "graph_test_util.h"
+#include "simple_graph.h"
+
+TEST(CsrGraph, internsNodes) {
+  CsrGraph graph(kBasicGraphEdges);
+
+  EXPECT_EQ(7, graph.getNumNodes());
+  EXPECT_EQ(8, graph.getNumEdges());
+
+  // IDs in order of first appearance.
+  ASSERT_TRUE(graph.findNode("A"));
+  EXPECT_EQ(0, *graph.findNode("A"));
+  EXPECT_EQ(2, *graph.findNode("C"));
+  EXPECT_EQ("K", graph.getName(4));
+  EXPECT_FALSE(graph.findNode("Q"));
+}
+
+TEST(CsrGraph, connections) {
+  CsrGraph graph(kBasicGraphEdges);
+
+  // B has both edges, in input order: back to A, then on to C.
+  const EdgeSpan edges = graph.getConnections(*graph.findNode("B"));
+  ASSERT_EQ(2, edges.size());
+  EXPECT_EQ("A", graph.getName(edges.begin()[0].target));
+  EXPECT_EQ(0.5, edges.begin()[0].cost);
+  EXPECT_EQ("C", graph.getName(edges.begin()[1].target));
+  EXPECT_EQ(4.0, edges.begin()[1].cost);
+
+  const EdgeSpan g_edges = graph.getConnections(*graph.findNode("G"));
+  ASSERT_EQ(1, g_edges.size());
+  EXPECT_DOUBLE_EQ(1.0 / 3.0, g_edges.begin()->cost);
+}
+
+TEST(LogCsrGraph, logsOfEdgeCosts) {
+  CsrGraph graph(kBasicGraphEdges);
+  LogCsrGraph log_graph(graph);
+
+  ASSERT_EQ(graph.getNumNodes(), log_graph.getNumNodes());
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    const EdgeSpan edges = graph.getConnections(node);
+    const auto log_edges = log_graph.getConnections(node);
+    ASSERT_EQ(edges.size(), log_edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      EXPECT_EQ(edges.begin()[i].target, log_edges.begin()[i].target);
+      EXPECT_EQ(std::log(edges.begin()[i].cost),
+                log_edges.begin()[i].cost.value);
+    }
+  }
+}
+
+TEST(SimpleGraph, adapterMatchesCsrGraph) {
+  SimpleGraph graph(kBasicGraphEdges);
+
+  EXPECT_EQ(std::vector<std::string>({"A", "B", "C", "G", "K", "X", "Z"}),
+            graph.getNodes());
+  EXPECT_EQ(V_ConnectionAndCost({{"A", 0.5}, {"C", 4.0}}),
+            graph.getConnections("B"));
+  EXPECT_TRUE(graph.getConnections("Q").empty());
+}
@@ -0,0 +1,374 @@
+// Graph traversal benchmarks. Prints one line per measurement.
+//
+// Usage: graph_benchmark [num_nodes]
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <new>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph_cost.h"
+#include "graph_snapshot.h"
+#include "query_helper.h"
+#include "ratio_finder.h"
+#include "ratio_index.h"
+#include "ratio_union_find.h"
+#include "simple_graph.h"
+
+// Counts every heap allocation in the process. Atomic, since the parallel
+// benchmarks allocate from worker threads; only the total is read.
+static std::atomic<size_t> g_num_allocations{0};
+
+void* operator new(size_t size) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// These free what the operator new above mallocs. GCC only sees the call to
+// operator new, once the atomic increment keeps it from being inlined, and
+// reports a mismatch.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+#pragma GCC diagnostic pop
+
+namespace {
+
+// Heap allocations made by fn.
+size_t countAllocations(std::function<void()> const& fn) {
+  const size_t before = g_num_allocations.load(std::memory_order_relaxed);
+  fn();
+  return g_num_allocations.load(std::memory_order_relaxed) - before;
+}
+
+// Returns wall time of fn, in milliseconds.
+double timeMs(std::function<void()> const& fn) {
+  const auto begin = std::chrono::steady_clock::now();
+  fn();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+// Random connected graph: a spanning tree plus as many extra random edges.
+V_GraphEdge makeGraph(int num_nodes) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> cost(0.5, 2.0);
+  V_GraphEdge edges;
+  for (int i = 1; i < num_nodes; ++i) {
+    std::uniform_int_distribution<int> parent(0, i - 1);
+    edges.push_back({"unit_" + std::to_string(parent(rng)),
+                     "unit_" + std::to_string(i), cost(rng)});
+  }
+  std::uniform_int_distribution<int> node(0, num_nodes - 1);
+  for (int i = 1; i < num_nodes; ++i) {
+    edges.push_back({"unit_" + std::to_string(node(rng)),
+                     "unit_" + std::to_string(node(rng)), cost(rng)});
+  }
+  return edges;
+}
+
+// Mean expanded/queued nodes and time per query, and the largest queue, for
+// queries under one search. stats is summed over the queries.
+void printSearchStats(const char* name, size_t num_queries,
+                      CostSearchStats const& stats, double ms) {
+  printf("  %-12s %8.0f expanded, %8.0f queued, %7zu max queue, %.3f ms "
+         "per query\n",
+         name, 1.0 * stats.expanded / num_queries,
+         1.0 * stats.queued / num_queries, stats.queue_peak,
+         ms / num_queries);
+}
+
+// Random queries on a dense graph under each findCost search.
+void benchmarkSearchModes(int num_nodes, int num_edges) {
+  std::mt19937 rng(13);
+  std::uniform_int_distribution<int> random_node(0, num_nodes - 1);
+  std::uniform_real_distribution<double> random_cost(0.5, 2.0);
+  V_GraphEdge edges;
+  for (int i = 0; i < num_edges; ++i) {
+    edges.push_back({"unit_" + std::to_string(random_node(rng)),
+                     "unit_" + std::to_string(random_node(rng)),
+                     random_cost(rng)});
+  }
+  CsrGraph graph(edges);
+  std::vector<CostQuery> queries;
+  for (int i = 0; i < 200; ++i) {
+    queries.push_back({*graph.findNode(edges[random_node(rng)].left),
+                       *graph.findNode(edges[random_node(rng)].right)});
+  }
+
+  // Per-edge uncertainty, the same in both directions.
+  auto edge_error = [](NodeId from, NodeId to, double) {
+    const uint64_t key = (uint64_t{std::min(from, to)} << 32) |
+                         std::max(from, to);
+    return 1.0 + static_cast<double>((key * 0x9E3779B97F4A7C15ull) >> 40) /
+                     (1 << 24);
+  };
+
+  printf("Search modes, %zu nodes, %zu edges:\n", graph.getNumNodes(),
+         graph.getNumEdges());
+  GraphTraversalContext<CsrGraph> context;
+  for (CostSearchMode mode :
+       {CostSearchMode::FIRST_FOUND, CostSearchMode::FEWEST_HOPS}) {
+    CostSearchStats stats;
+    double ms = timeMs([&] {
+      for (const auto& query : queries) {
+        findCost(graph, query.first, query.second, context, mode, &stats);
+      }
+    });
+    printSearchStats(mode == CostSearchMode::FIRST_FOUND ? "first found"
+                                                         : "fewest hops",
+                     queries.size(), stats, ms);
+  }
+  CostSearchStats stats;
+  double ms = timeMs([&] {
+    for (const auto& query : queries) {
+      findMinErrorCost(graph, query.first, query.second, edge_error, nullptr,
+                       &stats);
+    }
+  });
+  printSearchStats("min error", queries.size(), stats, ms);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_nodes = argc > 1 ? std::atoi(argv[1]) : 200000;
+  const V_GraphEdge edges = makeGraph(num_nodes);
+
+  std::vector<CsrGraph> csr_graphs;
+  double csr_build_ms = timeMs([&] { csr_graphs.emplace_back(edges); });
+  CsrGraph const& csr_graph = csr_graphs.front();
+  SimpleGraph simple_graph(edges);
+
+  // Full BFS through the string-keyed SimpleGraph API.
+  size_t simple_visited = 0;
+  double simple_ms = timeMs([&] {
+    std::set<std::string> visited = {"unit_0"};
+    std::deque<std::string> queue = {"unit_0"};
+    while (!queue.empty()) {
+      const std::string node = queue.front();
+      queue.pop_front();
+      for (const auto& conn : simple_graph.getConnections(node)) {
+        if (visited.insert(conn.first).second) {
+          queue.push_back(conn.first);
+        }
+      }
+    }
+    simple_visited = visited.size();
+  });
+
+  // Same BFS over interned IDs and edge spans.
+  size_t csr_visited = 0;
+  double csr_ms = timeMs([&] {
+    std::vector<bool> visited(csr_graph.getNumNodes());
+    std::vector<NodeId> queue = {*csr_graph.findNode("unit_0")};
+    visited[queue[0]] = true;
+    for (size_t i = 0; i < queue.size(); ++i) {
+      for (const CsrEdge& edge : csr_graph.getConnections(queue[i])) {
+        if (!visited[edge.target]) {
+          visited[edge.target] = true;
+          queue.push_back(edge.target);
+        }
+      }
+    }
+    csr_visited = queue.size();
+  });
+
+  printf("%d nodes, %zu edges: CsrGraph build %.1f ms\n", num_nodes,
+         csr_graph.getNumEdges(), csr_build_ms);
+  printf("  BFS SimpleGraph: %zu nodes in %.1f ms\n", simple_visited,
+         simple_ms);
+  printf("  BFS CsrGraph:    %zu nodes in %.1f ms (%.1fx)\n", csr_visited,
+         csr_ms, simple_ms / csr_ms);
+
+  // findCost / FindRootsAndBaseRatios through QueryHelper vs CsrGraph.
+  const std::string far_node = "unit_" + std::to_string(num_nodes - 1);
+  QueryHelper get_connections = [&](std::string start) {
+    return simple_graph.getConnections(start);
+  };
+  double cost = 0.0;
+  size_t helper_allocations = countAllocations(
+      [&] { cost = findCost(get_connections, "unit_0", far_node); });
+  double helper_ms =
+      timeMs([&] { findCost(get_connections, "unit_0", far_node); });
+  const NodeId start_id = *csr_graph.findNode("unit_0");
+  const NodeId far_id = *csr_graph.findNode(far_node);
+  size_t csr_allocations = countAllocations(
+      [&] { cost = findCost(csr_graph, start_id, far_id); });
+  double csr_cost_ms = timeMs([&] { findCost(csr_graph, start_id, far_id); });
+  GraphTraversalContext<CsrGraph> context;
+  findCost(csr_graph, start_id, far_id, context);
+  size_t reused_allocations = countAllocations(
+      [&] { cost = findCost(csr_graph, start_id, far_id, context); });
+  double reused_ms =
+      timeMs([&] { findCost(csr_graph, start_id, far_id, context); });
+  printf("findCost QueryHelper: %zu allocations, %.1f ms\n",
+         helper_allocations, helper_ms);
+  printf("findCost CsrGraph:    %zu allocations, %.1f ms\n", csr_allocations,
+         csr_cost_ms);
+  printf("findCost CsrGraph, reused context: %zu allocations, %.1f ms\n",
+         reused_allocations, reused_ms);
+  GraphTraversalContext<CsrGraph, LogRatio> log_context;
+  findLogCost(csr_graph, start_id, far_id, log_context);
+  double log_ms =
+      timeMs([&] { findLogCost(csr_graph, start_id, far_id, log_context); });
+  printf("findLogCost CsrGraph, reused context: %.1f ms\n", log_ms);
+  const LogCsrGraph log_graph(csr_graph);
+  double precomputed_log_ms =
+      timeMs([&] { findLogCost(log_graph, start_id, far_id, log_context); });
+  printf("findLogCost LogCsrGraph, reused context: %.1f ms\n",
+         precomputed_log_ms);
+
+  const std::vector<std::string> names = simple_graph.getNodes();
+  std::vector<NodeId> ids;
+  for (NodeId node = 0; node < csr_graph.getNumNodes(); ++node) {
+    ids.push_back(node);
+  }
+  std::map<std::string, ConnectionAndCost> helper_ratios;
+  helper_allocations = countAllocations(
+      [&] { FindRootsAndBaseRatios(names, get_connections, helper_ratios); });
+  std::map<NodeId, std::pair<NodeId, double>> csr_ratios;
+  double sequential_ms = 0.0;
+  csr_allocations = countAllocations([&] {
+    sequential_ms =
+        timeMs([&] { FindRootsAndBaseRatios(ids, csr_graph, csr_ratios); });
+  });
+  printf("FindRootsAndBaseRatios QueryHelper: %zu allocations\n",
+         helper_allocations);
+  printf("FindRootsAndBaseRatios CsrGraph:    %zu allocations, %.1f ms\n",
+         csr_allocations, sequential_ms);
+  csr_ratios.clear();
+  csr_allocations = countAllocations(
+      [&] { FindRootsAndBaseRatios(ids, csr_graph, csr_ratios, context); });
+  printf("FindRootsAndBaseRatios CsrGraph, reused context: %zu allocations "
+         "(%zu in the result map)\n",
+         csr_allocations, csr_ratios.size());
+  std::map<NodeId, std::pair<NodeId, double>> log_ratios;
+  double log_ratios_ms = timeMs(
+      [&] { FindRootsAndBaseLogRatios(ids, csr_graph, log_ratios); });
+  printf("FindRootsAndBaseLogRatios CsrGraph: %.1f ms\n", log_ratios_ms);
+  log_ratios.clear();
+  log_ratios_ms = timeMs([&] {
+    FindRootsAndBaseLogRatios(ids, log_graph, log_ratios, log_context);
+  });
+  printf("FindRootsAndBaseLogRatios LogCsrGraph, reused context: %.1f ms\n",
+         log_ratios_ms);
+  for (int num_threads : {1, 2, 4, 8}) {
+    std::vector<std::pair<NodeId, double>> parallel_ratios;
+    double parallel_ms = timeMs([&] {
+      FindRootsAndBaseRatiosParallel(csr_graph, num_threads, parallel_ratios);
+    });
+    printf("FindRootsAndBaseRatiosParallel, %d threads: %.1f ms\n",
+           num_threads, parallel_ms);
+  }
+
+  // Random queries: a search per query vs two lookups in a RatioIndex.
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> random_node(0, num_nodes - 1);
+  std::vector<std::pair<std::string, std::string>> queries;
+  for (int i = 0; i < 100000; ++i) {
+    queries.push_back({"unit_" + std::to_string(random_node(rng)),
+                       "unit_" + std::to_string(random_node(rng))});
+  }
+  const size_t num_search_queries = 20;
+  double search_ms = timeMs([&] {
+    for (size_t i = 0; i < num_search_queries; ++i) {
+      findCost(simple_graph, queries[i].first, queries[i].second);
+    }
+  });
+  std::vector<RatioIndex> indexes;
+  double index_build_ms =
+      timeMs([&] { indexes.emplace_back(simple_graph.getCsrGraph()); });
+  double checksum = 0.0;
+  double index_ms = timeMs([&] {
+    for (const auto& query : queries) {
+      checksum += indexes[0].findCost(query.first, query.second);
+    }
+  });
+  printf("findCost search:     %.1f queries/s\n",
+         1000.0 * num_search_queries / search_ms);
+  printf("RatioIndex findCost: %.0f queries/s (build %.1f ms, checksum %g)\n",
+         1000.0 * queries.size() / index_ms, index_build_ms, checksum);
+
+  // Online: insert every edge with a query after each, vs rebuilding the
+  // index once.
+  RatioUnionFind union_find;
+  double union_find_ms = timeMs([&] {
+    for (size_t i = 0; i < edges.size(); ++i) {
+      union_find.addEdge(edges[i].left, edges[i].right, edges[i].cost);
+      const auto& query = queries[i % queries.size()];
+      checksum += union_find.findCost(query.first, query.second);
+    }
+  });
+  printf("RatioUnionFind: %zu addEdge + findCost in %.1f ms (%.0f ns/op, "
+         "vs %.1f ms per index rebuild)\n",
+         edges.size(), union_find_ms, 1e6 * union_find_ms / edges.size() / 2,
+         index_build_ms);
+
+  benchmarkSearchModes(2000, 100000);
+
+  // Cold start: build graph and index from the edges, vs map a snapshot.
+  const std::string snapshot_path =
+      "/tmp/graph_benchmark_" + std::to_string(getpid()) + ".snapshot";
+  double save_ms = timeMs([&] { saveGraphSnapshot(snapshot_path, csr_graph); });
+  double rebuild_ms = timeMs([&] {
+    SimpleGraph graph(edges);
+    RatioIndex index(graph.getCsrGraph());
+    checksum += index.findCost(queries[0].first, queries[0].second);
+  });
+  double load_ms = timeMs([&] {
+    std::optional<GraphSnapshot> snapshot = loadGraphSnapshot(snapshot_path);
+    checksum += snapshot->findCost(queries[0].first, queries[0].second);
+  });
+  std::optional<GraphSnapshot> snapshot = loadGraphSnapshot(snapshot_path);
+  double snapshot_query_ms = timeMs([&] {
+    for (const auto& query : queries) {
+      checksum += snapshot->findCost(query.first, query.second);
+    }
+  });
+  std::remove(snapshot_path.c_str());
+  printf("Cold start to first query: rebuild %.1f ms, snapshot %.2f ms "
+         "(save %.1f ms)\n",
+         rebuild_ms, load_ms, save_ms);
+  printf("GraphSnapshot findCost: %.0f queries/s\n",
+         1000.0 * queries.size() / snapshot_query_ms);
+
+  // Batched: 10k queries from 100 starts, vs one search per query.
+  std::vector<CostQuery> batch;
+  for (int i = 0; i < 10000; ++i) {
+    batch.push_back({static_cast<NodeId>(random_node(rng) % 100),
+                     static_cast<NodeId>(random_node(rng))});
+  }
+  double single_ms = timeMs([&] {
+    for (size_t i = 0; i < num_search_queries; ++i) {
+      checksum += findCost(csr_graph, batch[i].first, batch[i].second);
+    }
+  });
+  double batch_ms = timeMs([&] { checksum += findCosts(csr_graph, batch)[0]; });
+  double threaded_ms =
+      timeMs([&] { checksum += findCosts(csr_graph, batch, 4)[0]; });
+  printf("findCost per query: %.1f queries/s\n",
+         1000.0 * num_search_queries / single_ms);
+  printf("findCosts batch:    %.0f queries/s, %.0f queries/s on 4 threads\n",
+         1000.0 * batch.size() / batch_ms, 1000.0 * batch.size() / threaded_ms);
+  return 0;
+}
@@ -1,46 +1,126 @@
 #include "graph_cost.h"
 
-#include <deque>
-#include <functional>
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // Find cost of a query in a graph.
 double findCost(QueryHelper const& get_connections, std::string start,
                 std::string end) {
-  const auto first_nodes = get_connections(start);
+  return findCost(QueryHelperGraph(get_connections), start, end);
+}
+
+namespace {
+
+// Per-thread buffers for findCosts, sized to the graph.
+struct BatchScratch {
+  explicit BatchScratch(size_t num_nodes)
+      : costs(num_nodes, -1), target_group(num_nodes, kNoGroup) {}
+
+  static constexpr size_t kNoGroup = std::numeric_limits<size_t>::max();
+
+  // Cost from the current start, or -1 if not reached. Only nodes in queue
+  // are set, and they're reset after each search.
+  std::vector<double> costs;
 
-  // Nodes that we need to search.
-  // intersection(active_nodes, visited) = NULL
-  std::deque<std::pair<std::string, double>> active_nodes(first_nodes.begin(),
-                                                          first_nodes.end());
+  // Group that last marked each node as a target. Groups are numbered
+  // uniquely within a findCosts call, so this never needs a reset.
+  std::vector<size_t> target_group;
 
-  // Visited: All nodes which have been consumed from active_nodes.
-  std::set<std::string> visited;
+  std::vector<NodeId> queue;
+};
 
-  while (!active_nodes.empty()) {
-    const std::pair<std::string, double> conn = active_nodes.front();
-    active_nodes.pop_front();
+}  // namespace
 
-    visited.insert(conn.first);
+std::vector<double> findCosts(CsrGraph const& graph,
+                              std::vector<CostQuery> const& queries,
+                              int num_threads) {
+  std::vector<double> results(queries.size());
 
-    if (conn.first == end) {
-      return conn.second;
+  // Query indices sorted by start. groups[i] .. groups[i + 1] share a start.
+  std::vector<size_t> order(queries.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return queries[a].first < queries[b].first;
+  });
+  std::vector<size_t> groups;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first) {
+      groups.push_back(i);
     }
+  }
+  groups.push_back(order.size());
+  const size_t num_groups = groups.size() - 1;
+
+  auto search = [&](size_t group, BatchScratch& scratch) {
+    const NodeId start = queries[order[groups[group]]].first;
 
-    const auto nearby_connections = get_connections(conn.first);
-    for (auto nearby : nearby_connections) {
-      if (visited.find(nearby.first) != visited.end()) {
-        continue;
+    // Distinct ends still to reach.
+    size_t remaining = 0;
+    for (size_t i = groups[group]; i < groups[group + 1]; ++i) {
+      const NodeId end = queries[order[i]].second;
+      if (scratch.target_group[end] != group) {
+        scratch.target_group[end] = group;
+        ++remaining;
       }
+    }
 
-      // Accumulate cost from current node.
-      nearby.second *= conn.second;
+    scratch.queue.clear();
+    scratch.queue.push_back(start);
+    scratch.costs[start] = 1.0;
+    if (scratch.target_group[start] == group) {
+      --remaining;
+    }
 
-      active_nodes.push_back(nearby);
+    // Breadth first, like findCost, so each node gets the same path's cost.
+    for (size_t head = 0; head < scratch.queue.size() && remaining > 0;
+         ++head) {
+      const NodeId node = scratch.queue[head];
+      for (const auto& [next, cost] : graph.getConnections(node)) {
+        if (scratch.costs[next] >= 0) {
+          continue;
+        }
+        scratch.costs[next] = scratch.costs[node] * cost;
+        scratch.queue.push_back(next);
+        if (scratch.target_group[next] == group && --remaining == 0) {
+          break;
+        }
+      }
     }
-  }
 
-  return -1;
+    for (size_t i = groups[group]; i < groups[group + 1]; ++i) {
+      results[order[i]] = scratch.costs[queries[order[i]].second];
+    }
+    for (const NodeId node : scratch.queue) {
+      scratch.costs[node] = -1;
+    }
+  };
+
+  // Threads pull the next start, so big components don't hold up a fixed
+  // share of the batch.
+  std::atomic<size_t> next_group(0);
+  auto work = [&]() {
+    BatchScratch scratch(graph.getNumNodes());
+    for (size_t i = next_group++; i < num_groups; i = next_group++) {
+      search(i, scratch);
+    }
+  };
+
+  const size_t num_workers =
+      std::min(static_cast<size_t>(std::max(num_threads, 1)), num_groups);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_workers; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
 }
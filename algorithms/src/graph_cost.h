@@ -1,9 +1,226 @@
+#ifndef INTERVIEW_PRACTICE_GRAPH_COST_H_
+#define INTERVIEW_PRACTICE_GRAPH_COST_H_
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <queue>
 #include <string>
+#include <utility>
 #include <vector>
-#include <functional>
 
+#include "csr_graph.h"
+#include "log_ratio.h"
 #include "query_helper.h"
+#include "traversal_context.h"
+
+// How findCost searches. Both modes are breadth first and return the same
+// cost: the first fewest-hop path found.
+enum class CostSearchMode {
+  // Marks nodes visited when popped, so a node can be queued once per edge
+  // into it.
+  FIRST_FOUND,
+  // Marks nodes visited when queued, so the queue never holds more than the
+  // node count.
+  FEWEST_HOPS,
+};
+
+// Counters for one findCost search.
+struct CostSearchStats {
+  size_t expanded = 0;    // Nodes popped from the queue.
+  size_t queued = 0;      // Pushes onto the queue.
+  size_t queue_peak = 0;  // Largest queue size.
+};
+
+namespace impl {
+
+// Breadth-first search from start for end. Sets cost and returns true if
+// they're connected. Ratio is double, or LogRatio to accumulate in log space.
+template <typename Graph, typename Ratio>
+bool searchCost(Graph const& graph, typename Graph::Node start,
+                typename Graph::Node end,
+                GraphTraversalContext<Graph, Ratio>& context,
+                Ratio& result, CostSearchMode mode = CostSearchMode::FIRST_FOUND,
+                CostSearchStats* stats = nullptr) {
+  using Node = typename Graph::Node;
+  context.clear();
+  const bool mark_on_push = mode == CostSearchMode::FEWEST_HOPS;
+  CostSearchStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+
+  // Nodes that we need to search.
+  // intersection(active_nodes, visited) = NULL
+  auto& active_nodes = context.queue;
+
+  // Visited: All nodes which have been consumed from active_nodes, or queued
+  // in FEWEST_HOPS. start isn't marked, so a query from start to itself
+  // returns a cycle's cost in both modes.
+  auto& visited = context.visited;
+
+  for (const auto& [node, cost] : graph.getConnections(start)) {
+    if (mark_on_push && !visited.insert(node)) {
+      continue;
+    }
+    active_nodes.push_back({node, unitRatio<Ratio>() * cost});
+    ++stats->queued;
+  }
+
+  while (!active_nodes.empty()) {
+    stats->queue_peak = std::max(stats->queue_peak, active_nodes.size());
+    const std::pair<Node, Ratio> conn = active_nodes.front();
+    active_nodes.pop_front();
+    ++stats->expanded;
+
+    visited.insert(conn.first);
+
+    if (conn.first == end) {
+      result = conn.second;
+      return true;
+    }
+
+    for (const auto& [node, cost] : graph.getConnections(conn.first)) {
+      if (mark_on_push ? !visited.insert(node) : visited.contains(node)) {
+        continue;
+      }
+
+      // Accumulate cost from current node.
+      active_nodes.push_back({node, conn.second * cost});
+      ++stats->queued;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace impl
+
+// Find cost of a query in a graph (see query_helper.h for the Graph
+// interface). Returns -1 if end isn't connected to start.
+//
+// context holds the search buffers; reuse it across calls to skip
+// reallocating them.
+template <typename Graph>
+double findCost(Graph const& graph, typename Graph::Node start,
+                typename Graph::Node end,
+                GraphTraversalContext<Graph>& context,
+                CostSearchMode mode = CostSearchMode::FIRST_FOUND,
+                CostSearchStats* stats = nullptr) {
+  double cost = -1;
+  impl::searchCost(graph, start, end, context, cost, mode, stats);
+  return cost;
+}
+
+template <typename Graph>
+double findCost(Graph const& graph, typename Graph::Node start,
+                typename Graph::Node end) {
+  GraphTraversalContext<Graph> context;
+  return findCost(graph, start, end, context);
+}
+
+// Natural log of findCost, accumulated in log space (see log_ratio.h), so long
+// paths don't overflow or underflow. Same search as findCost. Returns nullopt
+// if end isn't connected to start.
+//
+// Takes the log of each edge cost it crosses. Search a LogCsrGraph instead of
+// a CsrGraph to take the logs once per graph: it then costs the same as
+// findCost.
+template <typename Graph>
+std::optional<double> findLogCost(
+    Graph const& graph, typename Graph::Node start, typename Graph::Node end,
+    GraphTraversalContext<Graph, LogRatio>& context) {
+  LogRatio cost;
+  if (!impl::searchCost(graph, start, end, context, cost)) {
+    return std::nullopt;
+  }
+  return cost.log();
+}
+
+template <typename Graph>
+std::optional<double> findLogCost(Graph const& graph,
+                                  typename Graph::Node start,
+                                  typename Graph::Node end) {
+  GraphTraversalContext<Graph, LogRatio> context;
+  return findLogCost(graph, start, end, context);
+}
+
+// Find the cost of the path from start to end with the least total error,
+// where edge_error(from, to, cost) >= 0 is the error an edge adds (ex: the
+// uncertainty of a measured ratio). Dijkstra on the errors. Useful when
+// costs are inconsistent and paths disagree. Returns -1 if end isn't
+// connected to start; a query from start to itself costs 1.0.
+//
+// If error isn't null, it's set to the path's total error. stats counts
+// settled nodes as expanded.
+template <typename Graph, typename EdgeError>
+double findMinErrorCost(Graph const& graph, typename Graph::Node start,
+                        typename Graph::Node end, EdgeError const& edge_error,
+                        double* error = nullptr,
+                        CostSearchStats* stats = nullptr) {
+  using Node = typename Graph::Node;
+  struct Entry {
+    double error;
+    Node node;
+    double cost;
+    bool operator>(const Entry& other) const { return error > other.error; }
+  };
+  CostSearchStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+
+  // Lazy deletion: a node can be queued more than once, and only its first
+  // pop counts.
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  VisitedSet<Node, HasDenseNodeIds<Graph>::value> settled;
+  queue.push({0.0, start, 1.0});
+  ++stats->queued;
+  while (!queue.empty()) {
+    stats->queue_peak = std::max(stats->queue_peak, queue.size());
+    const Entry entry = queue.top();
+    queue.pop();
+    if (!settled.insert(entry.node)) {
+      continue;
+    }
+    ++stats->expanded;
+
+    if (entry.node == end) {
+      if (error) {
+        *error = entry.error;
+      }
+      return entry.cost;
+    }
+
+    for (const auto& [node, cost] : graph.getConnections(entry.node)) {
+      if (settled.contains(node)) {
+        continue;
+      }
+      queue.push({entry.error + edge_error(entry.node, node, cost), node,
+                  entry.cost * cost});
+      ++stats->queued;
+    }
+  }
+
+  return -1;
+}
 
 // Find cost of a query in a graph.
 double findCost(QueryHelper const& get_connections, std::string start,
                 std::string end);
+
+// One findCost query: (start, end).
+using CostQuery = std::pair<NodeId, NodeId>;
+
+// Answers many findCost queries at once. Queries are grouped by start, and
+// each distinct start gets one search that stops once all of its ends are
+// reached. Search buffers are reused across starts.
+//
+// Returns one cost per query, in order: the same as findCost, except that a
+// query from a node to itself costs 1.0. num_threads > 1 splits the starts
+// across that many threads.
+std::vector<double> findCosts(CsrGraph const& graph,
+                              std::vector<CostQuery> const& queries,
+                              int num_threads = 1);
+
+#endif  // INTERVIEW_PRACTICE_GRAPH_COST_H_
@@ -1,17 +1,17 @@
 #include "graph_cost.h"
 
 #include <cassert>
+#include <cmath>
 #include <map>
+#include <random>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
 
+#include "csr_graph.h"
+#include "graph_test_util.h"
 #include "simple_graph.h"
 
-static const V_GraphEdge kBasicGraphEdges = {
-    {"A", "B", 2.0}, {"B", "C", 4.0}, {"X", "K", 5.0}, {"Z", "G", 3.0},
-};
-
 TEST(SimpleGraph, easy_connections) {
   SimpleGraph graph(kBasicGraphEdges);
 
@@ -24,3 +24,159 @@ TEST(SimpleGraph, easy_connections) {
   EXPECT_EQ(-1, findCost(get_connections, "A", "K"));
   EXPECT_EQ(0.125, findCost(get_connections, "C", "A"));
 }
+
+// Same results through the templated graph interface.
+TEST(CsrGraph, findCost) {
+  SimpleGraph simple_graph(kBasicGraphEdges);
+  EXPECT_EQ(8.0, findCost(simple_graph, "A", "C"));
+  EXPECT_EQ(-1, findCost(simple_graph, "A", "K"));
+
+  CsrGraph graph(kBasicGraphEdges);
+  auto id = [&](const std::string& name) { return *graph.findNode(name); };
+  EXPECT_EQ(2.0, findCost(graph, id("A"), id("B")));
+  EXPECT_EQ(8.0, findCost(graph, id("A"), id("C")));
+  EXPECT_EQ(-1, findCost(graph, id("A"), id("K")));
+  EXPECT_EQ(0.125, findCost(graph, id("C"), id("A")));
+}
+
+// Batched queries match one findCost per query, on any number of threads.
+TEST(CsrGraph, findCosts) {
+  const V_GraphEdge edges = {
+      {"A", "B", 2.0}, {"B", "C", 4.0}, {"D", "C", 0.5}, {"E", "B", 3.0},
+      {"X", "K", 5.0}, {"K", "Y", 0.2}, {"Z", "G", 3.0},
+  };
+  CsrGraph graph(edges);
+
+  std::vector<CostQuery> queries;
+  std::vector<double> expected;
+  for (NodeId start = 0; start < graph.getNumNodes(); ++start) {
+    for (NodeId end = 0; end < graph.getNumNodes(); ++end) {
+      queries.push_back({start, end});
+      expected.push_back(start == end ? 1.0 : findCost(graph, start, end));
+    }
+  }
+  // Repeated and out of order.
+  queries.push_back({3, 0});
+  expected.push_back(findCost(graph, 3, 0));
+
+  EXPECT_EQ(expected, findCosts(graph, queries));
+  EXPECT_EQ(expected, findCosts(graph, queries, 4));
+  EXPECT_TRUE(findCosts(graph, {}).empty());
+}
+
+// Chain of num_hops edges of the same cost, from "0" to num_hops.
+static V_GraphEdge makeChain(int num_hops, double cost) {
+  V_GraphEdge edges;
+  for (int i = 0; i < num_hops; ++i) {
+    edges.push_back({std::to_string(i), std::to_string(i + 1), cost});
+  }
+  return edges;
+}
+
+TEST(CsrGraph, findLogCost) {
+  CsrGraph graph(kBasicGraphEdges);
+  auto id = [&](const std::string& name) { return *graph.findNode(name); };
+  EXPECT_DOUBLE_EQ(std::log(8.0), *findLogCost(graph, id("A"), id("C")));
+  EXPECT_DOUBLE_EQ(std::log(0.125), *findLogCost(graph, id("C"), id("A")));
+  EXPECT_FALSE(findLogCost(graph, id("A"), id("K")).has_value());
+}
+
+// 10k hops: the direct product overflows or underflows, the log doesn't. The
+// tolerance fails an uncompensated sum of logs (~1e-13 relative error).
+TEST(CsrGraph, findLogCostLongChain) {
+  const int kNumHops = 10000;
+  for (double cost : {1.1, 0.9, 1.0 + 1e-9}) {
+    CsrGraph graph(makeChain(kNumHops, cost));
+    const NodeId start = *graph.findNode("0");
+    const NodeId end = *graph.findNode(std::to_string(kNumHops));
+
+    // Reverse edges cost 1.0 / cost, rounded.
+    const long double expected =
+        kNumHops * std::log(static_cast<long double>(cost));
+    const long double reverse_expected =
+        kNumHops * std::log(static_cast<long double>(1.0 / cost));
+    EXPECT_NEAR(expected, *findLogCost(graph, start, end),
+                1e-15 * std::abs(expected))
+        << cost;
+    EXPECT_NEAR(reverse_expected, *findLogCost(graph, end, start),
+                1e-15 * std::abs(expected))
+        << cost;
+  }
+
+  CsrGraph graph(makeChain(kNumHops, 1.1));
+  EXPECT_TRUE(std::isinf(findCost(graph, *graph.findNode("0"),
+                                  *graph.findNode(std::to_string(kNumHops)))));
+}
+
+// Precomputed logs add up to exactly the same costs.
+TEST(LogCsrGraph, findLogCost) {
+  CsrGraph graph(makeChain(/*num_hops=*/1000, 1.1));
+  LogCsrGraph log_graph(graph);
+  GraphTraversalContext<LogCsrGraph, LogRatio> context;
+  for (NodeId start = 0; start < graph.getNumNodes(); start += 97) {
+    for (NodeId end = 0; end < graph.getNumNodes(); end += 89) {
+      EXPECT_EQ(findLogCost(graph, start, end),
+                findLogCost(log_graph, start, end, context));
+    }
+  }
+}
+
+// Marking on push gives the same costs with a queue bounded by the node count.
+TEST(CsrGraph, findCostFewestHops) {
+  // Dense, with inconsistent costs so that different paths disagree.
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> random_node(0, 39);
+  std::uniform_real_distribution<double> random_cost(0.5, 2.0);
+  V_GraphEdge edges;
+  for (int i = 0; i < 400; ++i) {
+    edges.push_back({std::to_string(random_node(rng)),
+                     std::to_string(random_node(rng)), random_cost(rng)});
+  }
+  CsrGraph graph(edges);
+
+  GraphTraversalContext<CsrGraph> context;
+  size_t first_found_queued = 0;
+  for (NodeId start = 0; start < graph.getNumNodes(); ++start) {
+    for (NodeId end = 0; end < graph.getNumNodes(); ++end) {
+      CostSearchStats first_found, fewest_hops;
+      const double expected = findCost(graph, start, end, context,
+                                       CostSearchMode::FIRST_FOUND,
+                                       &first_found);
+      EXPECT_EQ(expected, findCost(graph, start, end, context,
+                                   CostSearchMode::FEWEST_HOPS, &fewest_hops));
+      EXPECT_LE(fewest_hops.queued, graph.getNumNodes());
+      EXPECT_LE(fewest_hops.expanded, first_found.expanded);
+      first_found_queued += first_found.queued;
+    }
+  }
+  EXPECT_GT(first_found_queued, graph.getNumNodes() * graph.getNumNodes());
+}
+
+TEST(CsrGraph, findMinErrorCost) {
+  // The direct A-C edge disagrees with the path through B.
+  const V_GraphEdge edges = {
+      {"A", "B", 2.0}, {"B", "C", 4.0}, {"A", "C", 7.9}, {"X", "K", 5.0},
+  };
+  CsrGraph graph(edges);
+  auto id = [&](const std::string& name) { return *graph.findNode(name); };
+
+  // Each hop adds the same error: fewest hops.
+  auto hop_error = [](NodeId, NodeId, double) { return 1.0; };
+  double error = 0.0;
+  EXPECT_EQ(7.9, findMinErrorCost(graph, id("A"), id("C"), hop_error, &error));
+  EXPECT_EQ(1.0, error);
+
+  // An uncertain direct edge: the two-hop path wins.
+  auto uncertain_direct = [&](NodeId from, NodeId to, double) {
+    const bool direct = (from == id("A") && to == id("C")) ||
+                        (from == id("C") && to == id("A"));
+    return direct ? 10.0 : 1.0;
+  };
+  EXPECT_EQ(8.0, findMinErrorCost(graph, id("A"), id("C"), uncertain_direct,
+                                  &error));
+  EXPECT_EQ(2.0, error);
+  EXPECT_EQ(0.125, findMinErrorCost(graph, id("C"), id("A"), uncertain_direct));
+
+  EXPECT_EQ(-1, findMinErrorCost(graph, id("A"), id("K"), hop_error));
+  EXPECT_EQ(1.0, findMinErrorCost(graph, id("A"), id("A"), hop_error));
+}
@@ -0,0 +1,241 @@
+#include "graph_snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ratio_finder.h"
+
+namespace {
+
+const char kMagic[8] = {'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P'};
+const uint32_t kVersion = 1;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t num_nodes;
+  uint64_t num_edges;
+  uint64_t string_bytes;
+  char reserved_end[24];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "header must stay 64 bytes");
+static_assert(sizeof(CsrEdge) == 16, "edges are written as-is");
+
+size_t padded(size_t bytes) { return (bytes + 7) & ~size_t{7}; }
+
+// Byte offset of each section from the start of the file.
+struct SnapshotLayout {
+  explicit SnapshotLayout(const SnapshotHeader& header) {
+    name_offsets = sizeof(SnapshotHeader);
+    sorted_nodes =
+        name_offsets + padded(sizeof(uint64_t) * (header.num_nodes + 1));
+    edge_offsets =
+        sorted_nodes + padded(sizeof(uint32_t) * header.num_nodes);
+    edges = edge_offsets + padded(sizeof(uint32_t) * (header.num_nodes + 1));
+    roots = edges + sizeof(CsrEdge) * header.num_edges;
+    ratios = roots + padded(sizeof(uint32_t) * header.num_nodes);
+    strings = ratios + sizeof(double) * header.num_nodes;
+    size = strings + padded(header.string_bytes);
+  }
+
+  size_t name_offsets, sorted_nodes, edge_offsets, edges, roots, ratios,
+      strings, size;
+};
+
+// True if offsets[0 .. num_nodes] starts at 0, never decreases and ends at
+// total, so every range in it is in bounds.
+template <typename T>
+bool isValidOffsets(const T* offsets, size_t num_nodes, uint64_t total) {
+  if (offsets[0] != 0 || offsets[num_nodes] != total) {
+    return false;
+  }
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// True if every one of ids[0 .. count) is a node ID.
+bool isValidNodes(const uint32_t* ids, size_t count, size_t num_nodes) {
+  return std::all_of(ids, ids + count,
+                     [num_nodes](uint32_t id) { return id < num_nodes; });
+}
+
+// Writes size bytes of data, then zeros up to the next multiple of 8.
+bool writePadded(FILE* file, const void* data, size_t size) {
+  static const char kZeros[8] = {};
+  return std::fwrite(data, 1, size, file) == size &&
+         std::fwrite(kZeros, 1, padded(size) - size, file) ==
+             padded(size) - size;
+}
+
+template <typename T>
+bool writeSection(FILE* file, const std::vector<T>& values) {
+  return writePadded(file, values.data(), sizeof(T) * values.size());
+}
+
+}  // namespace
+
+bool saveGraphSnapshot(const std::string& path, const CsrGraph& graph) {
+  const NodeId num_nodes = static_cast<NodeId>(graph.getNumNodes());
+
+  std::vector<uint64_t> name_offsets = {0};
+  std::string strings;
+  std::vector<uint32_t> sorted_nodes;
+  std::vector<uint32_t> edge_offsets = {0};
+  std::vector<NodeId> ids;
+  for (NodeId node = 0; node < num_nodes; ++node) {
+    strings += graph.getName(node);
+    name_offsets.push_back(strings.size());
+    sorted_nodes.push_back(node);
+    edge_offsets.push_back(edge_offsets.back() + static_cast<uint32_t>(
+                               graph.getConnections(node).size()));
+  }
+  std::sort(sorted_nodes.begin(), sorted_nodes.end(),
+            [&](NodeId a, NodeId b) {
+              return graph.getName(a) < graph.getName(b);
+            });
+
+  // Zeroed, so the padding inside each edge is deterministic.
+  std::vector<CsrEdge> edges;
+  edges.reserve(graph.getNumEdges());
+  for (NodeId node = 0; node < num_nodes; ++node) {
+    for (const CsrEdge& edge : graph.getConnections(node)) {
+      edges.emplace_back();
+      std::memset(&edges.back(), 0, sizeof(CsrEdge));
+      edges.back().target = edge.target;
+      edges.back().cost = edge.cost;
+    }
+  }
+
+  std::vector<std::pair<NodeId, double>> roots_and_ratios;
+  FindRootsAndBaseRatiosParallel(graph, 1, roots_and_ratios);
+  std::vector<uint32_t> roots;
+  std::vector<double> ratios;
+  for (const auto& [root, ratio] : roots_and_ratios) {
+    roots.push_back(root);
+    ratios.push_back(ratio);
+  }
+
+  SnapshotHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_nodes = num_nodes;
+  header.num_edges = edges.size();
+  header.string_bytes = strings.size();
+
+  FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  ok = ok && writeSection(file, name_offsets);
+  ok = ok && writeSection(file, sorted_nodes);
+  ok = ok && writeSection(file, edge_offsets);
+  ok = ok && writeSection(file, edges);
+  ok = ok && writeSection(file, roots);
+  ok = ok && writeSection(file, ratios);
+  ok = ok && writePadded(file, strings.data(), strings.size());
+  return std::fclose(file) == 0 && ok;
+}
+
+std::optional<GraphSnapshot> loadGraphSnapshot(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+
+  struct stat file_stat;
+  SnapshotHeader header;
+  if (fstat(fd, &file_stat) != 0 ||
+      pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.num_nodes > UINT32_MAX ||
+      header.num_edges > UINT32_MAX ||
+      // Bounds string_bytes, so that the layout can't overflow.
+      header.string_bytes > static_cast<uint64_t>(file_stat.st_size) ||
+      static_cast<size_t>(file_stat.st_size) !=
+          SnapshotLayout(header).size) {
+    close(fd);
+    return std::nullopt;
+  }
+
+  const size_t length = file_stat.st_size;
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after closing the file.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+
+  const SnapshotLayout layout(header);
+  const char* base = static_cast<const char*>(mapping);
+  GraphSnapshot snapshot;
+  snapshot.mapping_ = std::shared_ptr<const void>(
+      mapping, [length](const void* data) {
+        munmap(const_cast<void*>(data), length);
+      });
+  snapshot.num_nodes_ = header.num_nodes;
+  snapshot.num_edges_ = header.num_edges;
+  snapshot.name_offsets_ =
+      reinterpret_cast<uint64_t const*>(base + layout.name_offsets);
+  snapshot.sorted_nodes_ =
+      reinterpret_cast<uint32_t const*>(base + layout.sorted_nodes);
+  snapshot.edge_offsets_ =
+      reinterpret_cast<uint32_t const*>(base + layout.edge_offsets);
+  snapshot.edges_ = reinterpret_cast<CsrEdge const*>(base + layout.edges);
+  snapshot.roots_ = reinterpret_cast<uint32_t const*>(base + layout.roots);
+  snapshot.ratios_ = reinterpret_cast<double const*>(base + layout.ratios);
+  snapshot.strings_ = base + layout.strings;
+
+  // One pass over every offset and node ID, so that no lookup can read out of
+  // bounds. The ratios and strings aren't read.
+  const size_t num_nodes = header.num_nodes;
+  if (!isValidOffsets(snapshot.name_offsets_, num_nodes,
+                      header.string_bytes) ||
+      !isValidOffsets(snapshot.edge_offsets_, num_nodes, header.num_edges) ||
+      !isValidNodes(snapshot.sorted_nodes_, num_nodes, num_nodes) ||
+      !isValidNodes(snapshot.roots_, num_nodes, num_nodes) ||
+      !std::all_of(snapshot.edges_, snapshot.edges_ + header.num_edges,
+                   [num_nodes](const CsrEdge& edge) {
+                     return edge.target < num_nodes;
+                   })) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+std::optional<NodeId> GraphSnapshot::findNode(std::string_view name) const {
+  auto iter = std::lower_bound(
+      sorted_nodes_, sorted_nodes_ + num_nodes_, name,
+      [this](uint32_t node, std::string_view value) {
+        return getName(node) < value;
+      });
+  if (iter == sorted_nodes_ + num_nodes_ || getName(*iter) != name) {
+    return std::nullopt;
+  }
+  return *iter;
+}
+
+double GraphSnapshot::findCost(std::string_view start,
+                               std::string_view end) const {
+  const std::optional<NodeId> start_id = findNode(start);
+  const std::optional<NodeId> end_id = findNode(end);
+  if (!start_id || !end_id || roots_[*start_id] != roots_[*end_id]) {
+    return -1;
+  }
+  return ratios_[*end_id] / ratios_[*start_id];
+}
@@ -0,0 +1,101 @@
+#ifndef INTERVIEW_PRACTICE_GRAPH_SNAPSHOT_H_
+#define INTERVIEW_PRACTICE_GRAPH_SNAPSHOT_H_
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "csr_graph.h"
+
+// Binary graph snapshot: a CsrGraph plus each node's root and ratio to the
+// root (see FindRootsAndBaseRatios), written so that it can be memory-mapped
+// and queried in place, without parsing or rebuilding anything.
+//
+// Format (native byte order): a 64 byte header, then sections, each padded
+// to 8 bytes.
+//
+//   char      magic[8]      "GRAPHSNP"
+//   uint32    version       1
+//   uint32    reserved
+//   uint64    num_nodes
+//   uint64    num_edges     Directed edges: 2 per input edge.
+//   uint64    string_bytes
+//   char      reserved[24]
+//
+//   uint64    name_offsets[num_nodes + 1]  Node i's name is strings[
+//                                          name_offsets[i] .. [i + 1]).
+//   uint32    sorted_nodes[num_nodes]      Node IDs in name order.
+//   uint32    edge_offsets[num_nodes + 1]  As in CsrGraph.
+//   CsrEdge   edges[num_edges]             uint32 target, 4 zero bytes,
+//                                          double cost.
+//   uint32    roots[num_nodes]
+//   double    ratios[num_nodes]            Cost from the root to the node.
+//   char      strings[string_bytes]
+
+// Writes graph to path. Returns false on I/O error.
+bool saveGraphSnapshot(const std::string& path, const CsrGraph& graph);
+
+// Read-only view of a memory-mapped snapshot. Same Graph interface as
+// CsrGraph (see query_helper.h), so it works with findCost and the other
+// traversals. Copies share the mapping.
+class GraphSnapshot {
+ public:
+  using Node = NodeId;
+  static constexpr bool kDenseNodeIds = true;
+
+  size_t getNumNodes() const { return num_nodes_; }
+  size_t getNumEdges() const { return num_edges_; }
+
+  // ID for name, or nullopt if the name isn't in the graph. Binary search
+  // over the names.
+  std::optional<NodeId> findNode(std::string_view name) const;
+
+  std::string_view getName(NodeId node) const {
+    return std::string_view(strings_ + name_offsets_[node],
+                            name_offsets_[node + 1] - name_offsets_[node]);
+  }
+
+  // Edges from node, pointing into the mapping.
+  EdgeSpan getConnections(NodeId node) const {
+    return EdgeSpan(edges_ + edge_offsets_[node],
+                    edges_ + edge_offsets_[node + 1]);
+  }
+
+  // Cost from start to end from the precomputed ratios, like RatioIndex, or
+  // -1 if they aren't connected or either isn't in the graph. Same result as
+  // findCost only if the edge costs are consistent (every path between two
+  // nodes has the same cost) and start != end: a query from a node to itself
+  // costs 1.0 here, where findCost returns the cost of a cycle back to it.
+  double findCost(std::string_view start, std::string_view end) const;
+
+ private:
+  friend std::optional<GraphSnapshot> loadGraphSnapshot(
+      const std::string& path);
+
+  GraphSnapshot() = default;
+
+  std::shared_ptr<const void> mapping_;
+  size_t num_nodes_ = 0;
+  size_t num_edges_ = 0;
+  uint64_t const* name_offsets_ = nullptr;
+  uint32_t const* sorted_nodes_ = nullptr;
+  uint32_t const* edge_offsets_ = nullptr;
+  CsrEdge const* edges_ = nullptr;
+  uint32_t const* roots_ = nullptr;
+  double const* ratios_ = nullptr;
+  char const* strings_ = nullptr;
+};
+
+// Memory-maps a file written by saveGraphSnapshot. Processes mapping the
+// same file share its pages.
+//
+// Returns nullopt if the file can't be opened or isn't a valid snapshot.
+// Loading checks the header and section sizes, and reads every offset and
+// node ID once to check that it's in bounds; the ratios and names are read on
+// first access. A corrupt ratio or name gives wrong answers, but no
+// out-of-bounds reads.
+std::optional<GraphSnapshot> loadGraphSnapshot(const std::string& path);
+
+#endif  // INTERVIEW_PRACTICE_GRAPH_SNAPSHOT_H_
@@ -0,0 +1,109 @@
+#include "graph_snapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "csr_graph.h"
+#include "graph_cost.h"
+#include "graph_test_util.h"
+#include "ratio_index.h"
+
+TEST(GraphSnapshot, roundTrip) {
+  CsrGraph graph(kBasicGraphEdges);
+  TempPath file;
+  ASSERT_TRUE(saveGraphSnapshot(file.path, graph));
+
+  std::optional<GraphSnapshot> snapshot = loadGraphSnapshot(file.path);
+  ASSERT_TRUE(snapshot.has_value());
+  ASSERT_EQ(graph.getNumNodes(), snapshot->getNumNodes());
+  ASSERT_EQ(graph.getNumEdges(), snapshot->getNumEdges());
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    EXPECT_EQ(graph.getName(node), snapshot->getName(node));
+    EXPECT_EQ(node, snapshot->findNode(graph.getName(node)));
+
+    EdgeSpan expected = graph.getConnections(node);
+    EdgeSpan edges = snapshot->getConnections(node);
+    ASSERT_EQ(expected.size(), edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      EXPECT_EQ(expected.begin()[i].target, edges.begin()[i].target);
+      EXPECT_EQ(expected.begin()[i].cost, edges.begin()[i].cost);
+    }
+  }
+  EXPECT_FALSE(snapshot->findNode("missing").has_value());
+  EXPECT_FALSE(snapshot->findNode("").has_value());
+}
+
+// Precomputed and searched costs match the in-memory graph.
+TEST(GraphSnapshot, findCost) {
+  CsrGraph graph(kBasicGraphEdges);
+  RatioIndex index(graph);
+  TempPath file;
+  ASSERT_TRUE(saveGraphSnapshot(file.path, graph));
+  std::optional<GraphSnapshot> snapshot = loadGraphSnapshot(file.path);
+  ASSERT_TRUE(snapshot.has_value());
+
+  for (NodeId start = 0; start < graph.getNumNodes(); ++start) {
+    for (NodeId end = 0; end < graph.getNumNodes(); ++end) {
+      const std::string& start_name = graph.getName(start);
+      const std::string& end_name = graph.getName(end);
+      EXPECT_EQ(index.findCost(start_name, end_name),
+                snapshot->findCost(start_name, end_name));
+      EXPECT_EQ(findCost(graph, start, end), findCost(*snapshot, start, end));
+    }
+  }
+  EXPECT_EQ(8.0, snapshot->findCost("A", "C"));
+  EXPECT_EQ(-1, snapshot->findCost("A", "missing"));
+}
+
+TEST(GraphSnapshot, rejectsBadFiles) {
+  EXPECT_FALSE(loadGraphSnapshot("/nonexistent/graph.snapshot").has_value());
+
+  TempPath file;
+  FILE* out = std::fopen(file.path.c_str(), "wb");
+  std::fputs("not a graph snapshot", out);
+  std::fclose(out);
+  EXPECT_FALSE(loadGraphSnapshot(file.path).has_value());
+
+  // Truncated.
+  ASSERT_TRUE(saveGraphSnapshot(file.path, CsrGraph(kBasicGraphEdges)));
+  ASSERT_EQ(0, truncate(file.path.c_str(), 100));
+  EXPECT_FALSE(loadGraphSnapshot(file.path).has_value());
+}
+
+// Offsets and node IDs out of bounds are rejected at load, instead of being
+// read past the mapping by a later lookup.
+TEST(GraphSnapshot, rejectsCorruptSections) {
+  // Section offsets for kBasicGraphEdges: 7 nodes, 8 directed edges.
+  const long kStringBytes = 32;   // In the header.
+  const long kNameOffsets = 64;   // uint64[8]
+  const long kSortedNodes = 128;  // uint32[7]
+  const long kEdgeOffsets = 160;  // uint32[8]
+  const long kEdges = 192;        // CsrEdge[8]
+  const long kRoots = 320;        // uint32[7]
+
+  TempPath file;
+  auto load_with = [&](long offset, auto value) {
+    EXPECT_TRUE(saveGraphSnapshot(file.path, CsrGraph(kBasicGraphEdges)));
+    FILE* out = std::fopen(file.path.c_str(), "r+b");
+    std::fseek(out, offset, SEEK_SET);
+    std::fwrite(&value, sizeof(value), 1, out);
+    std::fclose(out);
+    return loadGraphSnapshot(file.path).has_value();
+  };
+
+  // Unchanged values load.
+  EXPECT_TRUE(load_with(kNameOffsets + 8, uint64_t{1}));
+  EXPECT_TRUE(load_with(kEdges + 16, uint32_t{0}));
+
+  EXPECT_FALSE(load_with(kStringBytes, uint64_t{UINT64_MAX - 3}));
+  EXPECT_FALSE(load_with(kNameOffsets + 8, uint64_t{1} << 40));
+  EXPECT_FALSE(load_with(kNameOffsets, uint64_t{1}));
+  EXPECT_FALSE(load_with(kSortedNodes + 4, uint32_t{7}));
+  EXPECT_FALSE(load_with(kEdgeOffsets + 4, uint32_t{9}));
+  EXPECT_FALSE(load_with(kEdges + 16, uint32_t{1000000}));
+  EXPECT_FALSE(load_with(kRoots + 8, uint32_t{UINT32_MAX}));
+}
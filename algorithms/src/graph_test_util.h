@@ -0,0 +1,30 @@
+#ifndef INTERVIEW_PRACTICE_GRAPH_TEST_UTIL_H_
+#define INTERVIEW_PRACTICE_GRAPH_TEST_UTIL_H_
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "csr_graph.h"
+
+// Shared by the graph tests.
+
+// Three components: A -> B -> C (A to C costs 8), X -> K and Z -> G.
+inline const V_GraphEdge kBasicGraphEdges = {
+    {"A", "B", 2.0}, {"B", "C", 4.0}, {"X", "K", 5.0}, {"Z", "G", 3.0},
+};
+
+// Unique file path, removed at the end of the test.
+struct TempPath {
+  TempPath()
+      : path(testing::TempDir() + "graph_test_" + std::to_string(getpid()) +
+             "_" +
+             testing::UnitTest::GetInstance()->current_test_info()->name()) {}
+  ~TempPath() { std::remove(path.c_str()); }
+
+  const std::string path;
+};
+
+#endif  // INTERVIEW_PRACTICE_GRAPH_TEST_UTIL_H_
@@ -0,0 +1,53 @@
+#ifndef INTERVIEW_PRACTICE_LOG_RATIO_H_
+#define INTERVIEW_PRACTICE_LOG_RATIO_H_
+#include <cmath>
+
+// Natural log of an edge cost, taken ahead of time (see LogCsrGraph in
+// csr_graph.h). "ratio * cost" adds it as is, without another std::log.
+struct LogCost {
+  double value;
+};
+
+// Ratio along a path, kept as the sum of the log edge costs. Stands in for a
+// plain double ratio in the graph traversals: "ratio * cost" adds log(cost).
+//
+// A product of many costs overflows or underflows long before its log does.
+// The sum uses Neumaier (compensated) summation, so rounding error doesn't
+// grow with the path length.
+struct LogRatio {
+  double sum = 0.0;
+  double compensation = 0.0;
+
+  LogRatio operator*(double cost) const {
+    return *this * LogCost{std::log(cost)};
+  }
+
+  LogRatio operator*(LogCost cost) const {
+    const double term = cost.value;
+    const double new_sum = sum + term;
+    // Low-order bits lost from the smaller operand.
+    const double lost = std::abs(sum) >= std::abs(term)
+                            ? (sum - new_sum) + term
+                            : (term - new_sum) + sum;
+    return {new_sum, compensation + lost};
+  }
+
+  double log() const { return sum + compensation; }
+};
+
+// Ratio of an empty path.
+template <typename Ratio>
+Ratio unitRatio() {
+  return Ratio(1.0);
+}
+
+template <>
+inline LogRatio unitRatio<LogRatio>() {
+  return LogRatio();
+}
+
+// Plain value of a ratio: the ratio itself for double, its log for LogRatio.
+inline double ratioValue(double ratio) { return ratio; }
+inline double ratioValue(LogRatio ratio) { return ratio.log(); }
+
+#endif  // INTERVIEW_PRACTICE_LOG_RATIO_H_
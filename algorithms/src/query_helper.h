@@ -1,3 +1,5 @@
+#ifndef INTERVIEW_PRACTICE_QUERY_HELPER_H_
+#define INTERVIEW_PRACTICE_QUERY_HELPER_H_
 #include <functional>
 #include <string>
 #include <vector>
@@ -7,3 +9,40 @@ using V_ConnectionAndCost = std::vector<ConnectionAndCost>;
 
 // Accessor for costs of nearby nodes.
 using QueryHelper = std::function<V_ConnectionAndCost(std::string)>;
+
+// Graph algorithms (findCost, FindRootsAndBaseRatios) are templated on the
+// graph type. A Graph provides:
+//
+//   using Node = ...;  // Cheap to copy, ordered with operator<, hashable.
+//   Range getConnections(Node node) const;
+//
+// Range is anything iterable whose elements unpack into (neighbor, cost)
+// with structured bindings, ex: CsrGraph's EdgeSpan of CsrEdge. Returning a
+// view avoids copying the neighbors on every lookup.
+//
+// Optionally, a Graph whose nodes are integer IDs in [0, number of nodes)
+// declares
+//
+//   static constexpr bool kDenseNodeIds = true;
+//
+// so that traversals mark visited nodes in an array indexed by ID instead of
+// a hash set (see GraphTraversalContext).
+
+// Graph adapter for a QueryHelper. Every lookup copies, like the QueryHelper
+// itself; prefer a graph type with views.
+class QueryHelperGraph {
+ public:
+  using Node = std::string;
+
+  explicit QueryHelperGraph(QueryHelper const& get_connections)
+      : get_connections_(get_connections) {}
+
+  V_ConnectionAndCost getConnections(const Node& node) const {
+    return get_connections_(node);
+  }
+
+ private:
+  QueryHelper const& get_connections_;
+};
+
+#endif  // INTERVIEW_PRACTICE_QUERY_HELPER_H_
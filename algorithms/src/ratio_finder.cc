@@ -1,48 +1,142 @@
 #include "ratio_finder.h"
 
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <map>
-#include <vector>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "query_helper.h"
 
 void FindRootsAndBaseRatios(
     std::vector<std::string> const &nodes, QueryHelper const &get_connections,
     std::map<std::string, ConnectionAndCost> &node_roots_and_ratios) {
-  std::set<std::string> unused_nodes(nodes.begin(), nodes.end());
+  FindRootsAndBaseRatios(nodes, QueryHelperGraph(get_connections),
+                         node_roots_and_ratios);
+}
+
+namespace {
+
+// Runs work(thread_index) on num_threads threads, including the caller.
+void runOnThreads(int num_threads, std::function<void(int)> const &work) {
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work, i);
+  }
+  work(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// Lock-free union-find. A union links the larger root under the smaller, so
+// every component's root ends up being its smallest node.
+class ConcurrentUnionFind {
+ public:
+  explicit ConcurrentUnionFind(size_t num_nodes) : parents_(num_nodes) {
+    for (size_t i = 0; i < num_nodes; ++i) {
+      parents_[i].store(static_cast<NodeId>(i), std::memory_order_relaxed);
+    }
+  }
+
+  NodeId find(NodeId node) {
+    NodeId parent = parents_[node].load(std::memory_order_relaxed);
+    while (parent != node) {
+      // Path halving. Losing the race only skips a shortcut.
+      const NodeId grandparent =
+          parents_[parent].load(std::memory_order_relaxed);
+      parents_[node].compare_exchange_weak(parent, grandparent,
+                                           std::memory_order_relaxed);
+      node = parent;
+      parent = parents_[node].load(std::memory_order_relaxed);
+    }
+    return node;
+  }
 
-  while (!unused_nodes.empty()) {
-    const auto curr_root = *(unused_nodes.begin());
-    unused_nodes.erase(unused_nodes.begin());
+  void unite(NodeId a, NodeId b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      // a is still a root unless another thread linked it first.
+      NodeId expected = a;
+      if (parents_[a].compare_exchange_strong(expected, b,
+                                              std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
 
-    node_roots_and_ratios[curr_root] = {curr_root, 1.0};
+ private:
+  std::vector<std::atomic<NodeId>> parents_;
+};
 
-    // Look for all connections to the current root node. Add them to the output
-    // map.
-    std::deque<std::pair<std::string, double>> queue;
-    queue.push_back({curr_root, 1.0});
-    while (!queue.empty()) {
-      const auto node = queue.front();
-      queue.pop_front();
+}  // namespace
 
-      const auto nearby_connections = get_connections(node.first);
-      for (auto conn : nearby_connections) {
-        auto unused_node_iter = unused_nodes.find(conn.first);
+void FindRootsAndBaseRatiosParallel(
+    CsrGraph const &graph, int num_threads,
+    std::vector<std::pair<NodeId, double>> &node_roots_and_ratios) {
+  const size_t num_nodes = graph.getNumNodes();
+  num_threads = std::max(num_threads, 1);
+  auto slice = [&](int thread, size_t size) {
+    return std::make_pair(size * thread / num_threads,
+                          size * (thread + 1) / num_threads);
+  };
 
-        if (unused_node_iter == unused_nodes.end()) {
-          continue;
+  // Label components. Each edge is stored both ways; unite once.
+  ConcurrentUnionFind components(num_nodes);
+  runOnThreads(num_threads, [&](int thread) {
+    const auto [begin, end] = slice(thread, num_nodes);
+    for (size_t node = begin; node < end; ++node) {
+      for (const CsrEdge &edge :
+           graph.getConnections(static_cast<NodeId>(node))) {
+        if (edge.target > node) {
+          components.unite(static_cast<NodeId>(node), edge.target);
         }
+      }
+    }
+  });
 
-        // Put current connection in the result, pointing back to the subgraph
-        // root.
-        node_roots_and_ratios[conn.first] = {curr_root,
-                                             node.second * conn.second};
-        queue.push_back({conn.first, node.second * conn.second});
-
-        // Erase from global "unused" list.
-        unused_nodes.erase(unused_node_iter);
-      }  // nearby_connections loop
-    }    // subgraph loop
-  }      // outer graph (forest) loop
+  std::vector<NodeId> roots;
+  for (NodeId node = 0; node < num_nodes; ++node) {
+    if (components.find(node) == node) {
+      roots.push_back(node);
+    }
+  }
+
+  // Propagate ratios, one component per search. Each node is written only by
+  // the thread searching its component. NaN ratio: not reached yet.
+  constexpr double kUnset = std::numeric_limits<double>::quiet_NaN();
+  node_roots_and_ratios.assign(num_nodes, {0, kUnset});
+  std::atomic<size_t> next_root(0);
+  runOnThreads(num_threads, [&](int) {
+    RingQueue<NodeId> queue;
+    for (size_t i = next_root++; i < roots.size(); i = next_root++) {
+      const NodeId root = roots[i];
+      node_roots_and_ratios[root] = {root, 1.0};
+      queue.push_back(root);
+      while (!queue.empty()) {
+        const NodeId node = queue.front();
+        queue.pop_front();
+        const double ratio = node_roots_and_ratios[node].second;
+        for (const auto &[next, cost] : graph.getConnections(node)) {
+          if (!std::isnan(node_roots_and_ratios[next].second)) {
+            continue;
+          }
+          node_roots_and_ratios[next] = {root, ratio * cost};
+          queue.push_back(next);
+        }
+      }
+    }
+  });
 }
@@ -1,21 +1,132 @@
 #ifndef INTERVIEW_PRACTICE_RATIO_FINDER_H_
 #define INTERVIEW_PRACTICE_RATIO_FINDER_H_
 #include <algorithm>
-#include <deque>
 #include <functional>
 #include <map>
-#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "csr_graph.h"
+#include "log_ratio.h"
 #include "query_helper.h"
+#include "traversal_context.h"
+
+namespace impl {
+
+// FindRootsAndBaseRatios, accumulating ratios as Ratio: double, or LogRatio
+// for log space. The output holds ratioValue() of each ratio.
+template <typename Graph, typename Ratio>
+void findRootsAndRatios(
+    std::vector<typename Graph::Node> const &nodes, Graph const &graph,
+    std::map<typename Graph::Node, std::pair<typename Graph::Node, double>>
+        &node_roots_and_ratios,
+    GraphTraversalContext<Graph, Ratio> &context) {
+  using Node = typename Graph::Node;
+  context.clear();
+
+  // Input nodes not yet assigned to a subgraph. Visiting in sorted order
+  // makes each subgraph's root its smallest node.
+  auto &unused_nodes = context.visited;
+  for (const Node &node : nodes) {
+    unused_nodes.insert(node);
+  }
+  std::vector<Node> sorted_nodes(nodes.begin(), nodes.end());
+  std::sort(sorted_nodes.begin(), sorted_nodes.end());
+
+  auto &queue = context.queue;
+  for (const Node &curr_root : sorted_nodes) {
+    if (!unused_nodes.erase(curr_root)) {
+      continue;
+    }
+
+    node_roots_and_ratios[curr_root] = {curr_root,
+                                        ratioValue(unitRatio<Ratio>())};
+
+    // Look for all connections to the current root node. Add them to the output
+    // map.
+    queue.push_back({curr_root, unitRatio<Ratio>()});
+    while (!queue.empty()) {
+      const auto node = queue.front();
+      queue.pop_front();
+
+      for (const auto &[next, cost] : graph.getConnections(node.first)) {
+        // Erase from global "unused" list.
+        if (!unused_nodes.erase(next)) {
+          continue;
+        }
+
+        // Put current connection in the result, pointing back to the subgraph
+        // root.
+        const Ratio ratio = node.second * cost;
+        node_roots_and_ratios[next] = {curr_root, ratioValue(ratio)};
+        queue.push_back({next, ratio});
+      }  // nearby_connections loop
+    }    // subgraph loop
+  }      // outer graph (forest) loop
+}
+
+}  // namespace impl
 
 // For a given graph (nodes and edges), separate the graph into a multi-graph
-// with different ratios.
+// with different ratios. See query_helper.h for the Graph interface.
 //
 // Return value: map for each edge, with root node and ratio to the root node.
+// Each subgraph's root is its smallest node. context holds the search
+// buffers; reuse it across calls to skip reallocating them.
+template <typename Graph>
+void FindRootsAndBaseRatios(
+    std::vector<typename Graph::Node> const &nodes, Graph const &graph,
+    std::map<typename Graph::Node, std::pair<typename Graph::Node, double>>
+        &node_roots_and_ratios,
+    GraphTraversalContext<Graph> &context) {
+  impl::findRootsAndRatios(nodes, graph, node_roots_and_ratios, context);
+}
+
+template <typename Graph>
+void FindRootsAndBaseRatios(
+    std::vector<typename Graph::Node> const &nodes, Graph const &graph,
+    std::map<typename Graph::Node, std::pair<typename Graph::Node, double>>
+        &node_roots_and_ratios) {
+  GraphTraversalContext<Graph> context;
+  FindRootsAndBaseRatios(nodes, graph, node_roots_and_ratios, context);
+}
+
+// FindRootsAndBaseRatios in log space (see log_ratio.h): the same roots, with
+// the natural log of each ratio. Doesn't overflow or underflow on deep graphs.
+// On a LogCsrGraph, the edge logs are taken once per graph instead of once per
+// edge crossed.
+template <typename Graph>
+void FindRootsAndBaseLogRatios(
+    std::vector<typename Graph::Node> const &nodes, Graph const &graph,
+    std::map<typename Graph::Node, std::pair<typename Graph::Node, double>>
+        &node_roots_and_log_ratios,
+    GraphTraversalContext<Graph, LogRatio> &context) {
+  impl::findRootsAndRatios(nodes, graph, node_roots_and_log_ratios, context);
+}
+
+template <typename Graph>
+void FindRootsAndBaseLogRatios(
+    std::vector<typename Graph::Node> const &nodes, Graph const &graph,
+    std::map<typename Graph::Node, std::pair<typename Graph::Node, double>>
+        &node_roots_and_log_ratios) {
+  GraphTraversalContext<Graph, LogRatio> context;
+  FindRootsAndBaseLogRatios(nodes, graph, node_roots_and_log_ratios, context);
+}
+
 void FindRootsAndBaseRatios(
     std::vector<std::string> const &nodes, QueryHelper const &get_connections,
     std::map<std::string, ConnectionAndCost> &node_roots_and_ratios);
 
+// FindRootsAndBaseRatios over every node of a CsrGraph, on num_threads
+// threads. Components are labeled with a concurrent union-find over the
+// edges, then each component's ratios are filled in by one thread with the
+// same breadth-first search as FindRootsAndBaseRatios, so the roots and ratios
+// are identical.
+//
+// Return value: root and ratio to the root for each node, indexed by NodeId.
+void FindRootsAndBaseRatiosParallel(
+    CsrGraph const &graph, int num_threads,
+    std::vector<std::pair<NodeId, double>> &node_roots_and_ratios);
+
 #endif  // INTERVIEW_PRACTICE_RATIO_FINDER_H_
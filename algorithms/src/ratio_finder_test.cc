@@ -2,11 +2,13 @@
 
 #include <gtest/gtest.h>
 
-#include "simple_graph.h"
+#include <cmath>
+#include <random>
+#include <string>
 
-static const V_GraphEdge kBasicGraphEdges = {
-    {"A", "B", 2.0}, {"B", "C", 4.0}, {"X", "K", 5.0}, {"Z", "G", 3.0},
-};
+#include "csr_graph.h"
+#include "graph_test_util.h"
+#include "simple_graph.h"
 
 TEST(RatioFinder, singleRootNode) {
   SimpleGraph graph(kBasicGraphEdges);
@@ -21,3 +23,76 @@ TEST(RatioFinder, singleRootNode) {
 
   EXPECT_EQ(result.size(), 7);
 }
+
+TEST(RatioFinder, csrGraph) {
+  CsrGraph graph(kBasicGraphEdges);
+  std::vector<NodeId> nodes;
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    nodes.push_back(node);
+  }
+
+  std::map<NodeId, std::pair<NodeId, double>> result;
+  FindRootsAndBaseRatios(nodes, graph, result);
+
+  ASSERT_EQ(result.size(), 7);
+  const NodeId a = *graph.findNode("A");
+  const NodeId c = *graph.findNode("C");
+  EXPECT_EQ(a, result[c].first);
+  EXPECT_EQ(8.0, result[c].second);
+  EXPECT_NE(a, result[*graph.findNode("K")].first);
+}
+
+// Logs of FindRootsAndBaseRatios, the same with precomputed logs.
+TEST(RatioFinder, logRatios) {
+  CsrGraph graph(kBasicGraphEdges);
+  std::vector<NodeId> nodes;
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    nodes.push_back(node);
+  }
+  std::map<NodeId, std::pair<NodeId, double>> ratios, log_ratios;
+  FindRootsAndBaseRatios(nodes, graph, ratios);
+  FindRootsAndBaseLogRatios(nodes, graph, log_ratios);
+
+  ASSERT_EQ(ratios.size(), log_ratios.size());
+  for (const auto &[node, root_and_ratio] : ratios) {
+    EXPECT_EQ(root_and_ratio.first, log_ratios[node].first);
+    EXPECT_DOUBLE_EQ(std::log(root_and_ratio.second),
+                     log_ratios[node].second);
+  }
+
+  LogCsrGraph log_graph(graph);
+  GraphTraversalContext<LogCsrGraph, LogRatio> context;
+  for (int i = 0; i < 2; ++i) {
+    std::map<NodeId, std::pair<NodeId, double>> result;
+    FindRootsAndBaseLogRatios(nodes, log_graph, result, context);
+    EXPECT_EQ(log_ratios, result);
+  }
+}
+
+// Same roots and ratios as the sequential search, on any number of threads.
+TEST(RatioFinder, parallel) {
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int> random_node(0, 299);
+  std::uniform_real_distribution<double> random_cost(0.5, 2.0);
+  V_GraphEdge edges;
+  for (int i = 0; i < 250; ++i) {
+    edges.push_back({std::to_string(random_node(rng)),
+                     std::to_string(random_node(rng)), random_cost(rng)});
+  }
+  CsrGraph graph(edges);
+  std::vector<NodeId> nodes;
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    nodes.push_back(node);
+  }
+  std::map<NodeId, std::pair<NodeId, double>> expected;
+  FindRootsAndBaseRatios(nodes, graph, expected);
+
+  for (int num_threads : {1, 2, 4}) {
+    std::vector<std::pair<NodeId, double>> result;
+    FindRootsAndBaseRatiosParallel(graph, num_threads, result);
+    ASSERT_EQ(expected.size(), result.size());
+    for (const auto &[node, root_and_ratio] : expected) {
+      EXPECT_EQ(root_and_ratio, result[node]) << "node " << node;
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#include "ratio_index.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ratio_finder.h"
+
+RatioIndex::RatioIndex(const CsrGraph& graph) {
+  std::vector<NodeId> nodes;
+  nodes.reserve(graph.getNumNodes());
+  for (NodeId node = 0; node < graph.getNumNodes(); ++node) {
+    nodes.push_back(node);
+  }
+
+  std::map<NodeId, std::pair<NodeId, double>> node_roots_and_ratios;
+  FindRootsAndBaseRatios(nodes, graph, node_roots_and_ratios);
+
+  roots_and_ratios_.reserve(node_roots_and_ratios.size());
+  for (const auto& [node, root_and_ratio] : node_roots_and_ratios) {
+    roots_and_ratios_[graph.getName(node)] = {root_and_ratio.first,
+                                              root_and_ratio.second};
+  }
+}
+
+double RatioIndex::findCost(const std::string& start,
+                            const std::string& end) const {
+  auto start_iter = roots_and_ratios_.find(start);
+  auto end_iter = roots_and_ratios_.find(end);
+  if (start_iter == roots_and_ratios_.end() ||
+      end_iter == roots_and_ratios_.end() ||
+      start_iter->second.root != end_iter->second.root) {
+    return -1;
+  }
+  return end_iter->second.ratio / start_iter->second.ratio;
+}
@@ -0,0 +1,37 @@
+#ifndef INTERVIEW_PRACTICE_RATIO_INDEX_H_
+#define INTERVIEW_PRACTICE_RATIO_INDEX_H_
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "csr_graph.h"
+
+// Answers findCost queries from precomputed ratios instead of a graph search.
+//
+// Built once with FindRootsAndBaseRatios: every node stores its component
+// root and the cost from the root to it. For nodes in the same component,
+// cost(start, end) = ratio(end) / ratio(start). Assumes the edge costs are
+// consistent (every path between two nodes has the same cost), which is what
+// findCost assumes too.
+//
+// Immutable once built.
+class RatioIndex {
+ public:
+  explicit RatioIndex(const CsrGraph& graph);
+
+  // Same result as findCost: cost from start to end, or -1 if they aren't
+  // connected or either isn't in the graph.
+  double findCost(const std::string& start, const std::string& end) const;
+
+  size_t getNumNodes() const { return roots_and_ratios_.size(); }
+
+ private:
+  struct RootAndRatio {
+    NodeId root;
+    double ratio;
+  };
+
+  std::unordered_map<std::string, RootAndRatio> roots_and_ratios_;
+};
+
+#endif  // INTERVIEW_PRACTICE_RATIO_INDEX_H_
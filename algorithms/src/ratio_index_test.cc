@@ -0,0 +1,41 @@
+#include "ratio_index.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "csr_graph.h"
+#include "graph_cost.h"
+#include "graph_test_util.h"
+#include "simple_graph.h"
+
+TEST(RatioIndex, basic) {
+  CsrGraph graph(kBasicGraphEdges);
+  RatioIndex index(graph);
+
+  EXPECT_EQ(7, index.getNumNodes());
+  EXPECT_EQ(2.0, index.findCost("A", "B"));
+  EXPECT_EQ(8.0, index.findCost("A", "C"));
+  EXPECT_EQ(0.125, index.findCost("C", "A"));
+  EXPECT_EQ(0.25, index.findCost("C", "B"));
+  EXPECT_EQ(1.0 / 3.0, index.findCost("G", "Z"));
+  EXPECT_EQ(-1, index.findCost("A", "K"));
+  EXPECT_EQ(-1, index.findCost("A", "missing"));
+}
+
+// Every pair matches a graph search.
+TEST(RatioIndex, matchesFindCost) {
+  const V_GraphEdge edges = {
+      {"A", "B", 2.0}, {"B", "C", 4.0}, {"D", "C", 0.5}, {"A", "D", 16.0},
+      {"E", "B", 3.0}, {"X", "K", 5.0}, {"K", "Y", 0.2},
+  };
+  SimpleGraph graph(edges);
+  RatioIndex index(graph.getCsrGraph());
+
+  for (const std::string& start : graph.getNodes()) {
+    for (const std::string& end : graph.getNodes()) {
+      EXPECT_DOUBLE_EQ(findCost(graph, start, end), index.findCost(start, end))
+          << start << " -> " << end;
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#include "ratio_union_find.h"
+
+#include <string>
+#include <utility>
+
+RatioUnionFind::RatioUnionFind(const V_GraphEdge& edges) {
+  for (const auto& edge : edges) {
+    addEdge(edge.left, edge.right, edge.cost);
+  }
+}
+
+NodeId RatioUnionFind::intern(const std::string& name) {
+  auto inserted = ids_.emplace(name, static_cast<NodeId>(parents_.size()));
+  if (inserted.second) {
+    parents_.push_back(inserted.first->second);
+    ratios_.push_back(1.0);
+    ranks_.push_back(0);
+  }
+  return inserted.first->second;
+}
+
+NodeId RatioUnionFind::find(NodeId node) {
+  path_.clear();
+  while (parents_[node] != node) {
+    path_.push_back(node);
+    node = parents_[node];
+  }
+  const NodeId root = node;
+
+  // Walk back down from the node just below the root. Each parent already
+  // points at the root, so its ratio is the cost from the root.
+  for (size_t i = path_.size(); i-- > 1;) {
+    const NodeId child = path_[i - 1];
+    ratios_[child] *= ratios_[parents_[child]];
+    parents_[child] = root;
+  }
+  return root;
+}
+
+void RatioUnionFind::addEdge(const std::string& left, const std::string& right,
+                             double cost) {
+  const NodeId left_id = intern(left);
+  const NodeId right_id = intern(right);
+  NodeId left_root = find(left_id);
+  NodeId right_root = find(right_id);
+  if (left_root == right_root) {
+    return;
+  }
+
+  // Cost from left_root to right_root, through the new edge.
+  double root_cost = ratios_[left_id] * cost / ratios_[right_id];
+  if (ranks_[left_root] < ranks_[right_root]) {
+    std::swap(left_root, right_root);
+    root_cost = 1.0 / root_cost;
+  }
+  parents_[right_root] = left_root;
+  ratios_[right_root] = root_cost;
+  if (ranks_[left_root] == ranks_[right_root]) {
+    ++ranks_[left_root];
+  }
+}
+
+double RatioUnionFind::findCost(const std::string& start,
+                                const std::string& end) {
+  auto start_iter = ids_.find(start);
+  auto end_iter = ids_.find(end);
+  if (start_iter == ids_.end() || end_iter == ids_.end()) {
+    return -1;
+  }
+  const NodeId start_id = start_iter->second;
+  const NodeId end_id = end_iter->second;
+  if (find(start_id) != find(end_id)) {
+    return -1;
+  }
+  return ratios_[end_id] / ratios_[start_id];
+}
@@ -0,0 +1,47 @@
+#ifndef INTERVIEW_PRACTICE_RATIO_UNION_FIND_H_
+#define INTERVIEW_PRACTICE_RATIO_UNION_FIND_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "csr_graph.h"
+
+// Ratio graph that takes edges one at a time. Weighted union-find: each node
+// stores its parent and the cost from the parent to it, so the cost from a
+// node's root is the product along its parent chain. Path compression and
+// union by rank keep each operation amortized near-constant.
+//
+// Answers the same queries as findCost, assuming consistent edge costs (every
+// path between two nodes has the same cost). An edge between two nodes that
+// are already connected adds nothing.
+class RatioUnionFind {
+ public:
+  RatioUnionFind() = default;
+  explicit RatioUnionFind(const V_GraphEdge& edges);
+
+  // Cost from left to right is cost, and right to left is 1.0 / cost.
+  void addEdge(const std::string& left, const std::string& right, double cost);
+
+  // Same result as findCost: cost from start to end, or -1 if they aren't
+  // connected or either isn't in the graph. Compresses paths, so not const.
+  double findCost(const std::string& start, const std::string& end);
+
+  size_t getNumNodes() const { return parents_.size(); }
+
+ private:
+  NodeId intern(const std::string& name);
+
+  // Root of node. Afterwards node's parent is the root, and ratios_[node] is
+  // the cost from the root.
+  NodeId find(NodeId node);
+
+  std::unordered_map<std::string, NodeId> ids_;
+  std::vector<NodeId> parents_;
+  std::vector<double> ratios_;  // Cost from parent to node.
+  std::vector<uint8_t> ranks_;
+  std::vector<NodeId> path_;  // Scratch for find().
+};
+
+#endif  // INTERVIEW_PRACTICE_RATIO_UNION_FIND_H_
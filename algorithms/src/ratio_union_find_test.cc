@@ -0,0 +1,66 @@
+#include "ratio_union_find.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "graph_cost.h"
+#include "graph_test_util.h"
+#include "simple_graph.h"
+
+TEST(RatioUnionFind, basic) {
+  RatioUnionFind ratios(kBasicGraphEdges);
+
+  EXPECT_EQ(7, ratios.getNumNodes());
+  EXPECT_EQ(2.0, ratios.findCost("A", "B"));
+  EXPECT_EQ(8.0, ratios.findCost("A", "C"));
+  EXPECT_EQ(0.125, ratios.findCost("C", "A"));
+  EXPECT_EQ(1.0, ratios.findCost("C", "C"));
+  EXPECT_EQ(-1, ratios.findCost("A", "K"));
+  EXPECT_EQ(-1, ratios.findCost("A", "missing"));
+
+  // Joining two components.
+  ratios.addEdge("K", "C", 0.5);
+  EXPECT_EQ(16.0, ratios.findCost("A", "K"));
+  EXPECT_EQ(3.2, ratios.findCost("A", "X"));
+  EXPECT_EQ(0.3125, ratios.findCost("X", "A"));
+}
+
+// After every insert, matches a graph search over the edges so far.
+TEST(RatioUnionFind, matchesFindCostOnline) {
+  const int kNumNodes = 30;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> random_node(0, kNumNodes - 1);
+  std::uniform_real_distribution<double> random_value(0.5, 2.0);
+
+  // Costs derived from per-node values are consistent around any cycle.
+  std::vector<double> values;
+  for (int i = 0; i < kNumNodes; ++i) {
+    values.push_back(random_value(rng));
+  }
+
+  RatioUnionFind ratios;
+  V_GraphEdge edges;
+  for (int i = 0; i < 40; ++i) {
+    const int left = random_node(rng);
+    const int right = random_node(rng);
+    edges.push_back({std::to_string(left), std::to_string(right),
+                     values[right] / values[left]});
+    ratios.addEdge(edges.back().left, edges.back().right, edges.back().cost);
+
+    SimpleGraph graph(edges);
+    for (const std::string& start : graph.getNodes()) {
+      for (const std::string& end : graph.getNodes()) {
+        const double expected = findCost(graph, start, end);
+        if (expected < 0) {
+          EXPECT_EQ(-1, ratios.findCost(start, end));
+        } else {
+          EXPECT_NEAR(expected, ratios.findCost(start, end), 1e-9 * expected)
+              << start << " -> " << end;
+        }
+      }
+    }
+  }
+}
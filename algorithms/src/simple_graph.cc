@@ -1,31 +1,34 @@
 #include "simple_graph.h"
 
+#include <algorithm>
+
 #include "query_helper.h"
 
-SimpleGraph::SimpleGraph(const V_GraphEdge& edges) {
-  // std::map operator[] will default initialize if key is not found.
-  for (const auto& conn : edges) {
-    connections_[conn.left].push_back({conn.right, conn.cost});
-    connections_[conn.right].push_back({conn.left, 1.0 / conn.cost});
-  }
-}
+SimpleGraph::SimpleGraph(const V_GraphEdge& edges) : graph_(edges) {}
 
 V_ConnectionAndCost SimpleGraph::getConnections(std::string start) const {
-  auto node_connections = connections_.find(start);
-  if (node_connections == connections_.end()) {
+  const auto node = graph_.findNode(start);
+  if (!node) {
     return {};
   }
 
-  return node_connections->second;
+  V_ConnectionAndCost result;
+  const EdgeSpan edges = graph_.getConnections(*node);
+  result.reserve(edges.size());
+  for (const CsrEdge& edge : edges) {
+    result.push_back({graph_.getName(edge.target), edge.cost});
+  }
+  return result;
 }
 
 std::vector<std::string> SimpleGraph::getNodes() const {
   std::vector<std::string> result;
-  result.reserve(connections_.size());
+  result.reserve(graph_.getNumNodes());
 
-  for (auto conn : connections_) {
-    result.push_back(conn.first);
+  for (NodeId node = 0; node < graph_.getNumNodes(); ++node) {
+    result.push_back(graph_.getName(node));
   }
+  std::sort(result.begin(), result.end());
 
   return result;
 }
@@ -1,28 +1,27 @@
+#ifndef INTERVIEW_PRACTICE_SIMPLE_GRAPH_H_
+#define INTERVIEW_PRACTICE_SIMPLE_GRAPH_H_
 #include <string>
 #include <vector>
-#include <map>
 
+#include "csr_graph.h"
 #include "query_helper.h"
 
-// Each graph edge gives the cost from left->right.
-// Cost from right->left is the multiplicative inverse (1.0 / COST).
-struct GraphEdge {
-  std::string left;
-  std::string right;
-  double cost;
-};
-
-using V_GraphEdge = std::vector<GraphEdge>;
-
-// Simple graph for testing.
+// Simple graph for testing. String-keyed adapter over CsrGraph.
 class SimpleGraph {
  public:
+  using Node = std::string;
+
   SimpleGraph(const V_GraphEdge& edges);
 
   V_ConnectionAndCost getConnections(std::string start) const;
 
+  // Sorted node names.
   std::vector<std::string> getNodes() const;
 
+  const CsrGraph& getCsrGraph() const { return graph_; }
+
  private:
-  std::map<std::string, V_ConnectionAndCost> connections_;
+  CsrGraph graph_;
 };
+
+#endif  // INTERVIEW_PRACTICE_SIMPLE_GRAPH_H_
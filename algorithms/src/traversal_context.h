@@ -0,0 +1,150 @@
+#ifndef INTERVIEW_PRACTICE_TRAVERSAL_CONTEXT_H_
+#define INTERVIEW_PRACTICE_TRAVERSAL_CONTEXT_H_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// FIFO queue over a power-of-two ring buffer. clear() keeps the buffer, so a
+// reused queue stops allocating once it has grown to the largest traversal.
+template <typename T>
+class RingQueue {
+ public:
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  const T& front() const { return buffer_[head_]; }
+
+  void push_back(T value) {
+    if (size_ == buffer_.size()) {
+      grow();
+    }
+    buffer_[(head_ + size_) & (buffer_.size() - 1)] = std::move(value);
+    ++size_;
+  }
+
+  void pop_front() {
+    head_ = (head_ + 1) & (buffer_.size() - 1);
+    --size_;
+  }
+
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+ private:
+  void grow() {
+    std::vector<T> buffer(buffer_.empty() ? 16 : 2 * buffer_.size());
+    for (size_t i = 0; i < size_; ++i) {
+      buffer[i] = std::move(buffer_[(head_ + i) & (buffer_.size() - 1)]);
+    }
+    buffer_.swap(buffer);
+    head_ = 0;
+  }
+
+  std::vector<T> buffer_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+// Set of visited nodes. Hashed, unless DenseIds (see the specialization).
+template <typename Node, bool DenseIds = false>
+class VisitedSet {
+ public:
+  // Returns false if node was already in the set.
+  bool insert(const Node& node) { return nodes_.insert(node).second; }
+  bool contains(const Node& node) const { return nodes_.count(node) != 0; }
+
+  // Returns false if node wasn't in the set.
+  bool erase(const Node& node) { return nodes_.erase(node) != 0; }
+
+  // Keeps the buckets.
+  void clear() { nodes_.clear(); }
+
+ private:
+  std::unordered_set<Node> nodes_;
+};
+
+// Dense integer IDs (ex: CsrGraph's NodeId): one stamp per ID. A node is in
+// the set if its stamp is the current epoch, so clear() is O(1).
+//
+// Memory grows with the largest ID inserted, so this is opt-in: only for IDs
+// in [0, number of nodes). Sparse IDs (ex: 1e9) would allocate gigabytes.
+template <typename Node>
+class VisitedSet<Node, true> {
+  static_assert(std::is_integral_v<Node>, "dense IDs must be integers");
+
+ public:
+  bool insert(Node node) {
+    const size_t index = static_cast<size_t>(node);
+    if (index >= stamps_.size()) {
+      stamps_.resize(std::max(index + 1, 2 * stamps_.size()), 0);
+    }
+    if (stamps_[index] == epoch_) {
+      return false;
+    }
+    stamps_[index] = epoch_;
+    return true;
+  }
+
+  bool contains(Node node) const {
+    const size_t index = static_cast<size_t>(node);
+    return index < stamps_.size() && stamps_[index] == epoch_;
+  }
+
+  bool erase(Node node) {
+    if (!contains(node)) {
+      return false;
+    }
+    stamps_[static_cast<size_t>(node)] = 0;
+    return true;
+  }
+
+  void clear() {
+    if (++epoch_ == 0) {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+ private:
+  std::vector<uint32_t> stamps_;
+  uint32_t epoch_ = 1;
+};
+
+// Buffers for one breadth-first traversal at a time (findCost,
+// FindRootsAndBaseRatios). Reuse one across calls to avoid reallocating them;
+// not thread safe. Ratio is double, or LogRatio for log-space traversals.
+//
+// Use GraphTraversalContext to pick DenseIds from the graph type.
+template <typename Node, typename Ratio = double, bool DenseIds = false>
+struct TraversalContext {
+  VisitedSet<Node, DenseIds> visited;
+  RingQueue<std::pair<Node, Ratio>> queue;
+
+  void clear() {
+    visited.clear();
+    queue.clear();
+  }
+};
+
+// True if Graph opts in to dense node IDs with "static constexpr bool
+// kDenseNodeIds = true" (see query_helper.h).
+template <typename Graph, typename Enable = void>
+struct HasDenseNodeIds : std::false_type {};
+
+template <typename Graph>
+struct HasDenseNodeIds<Graph, std::enable_if_t<Graph::kDenseNodeIds>>
+    : std::true_type {};
+
+// Context for traversals of Graph: dense visited set if Graph opts in.
+template <typename Graph, typename Ratio = double>
+using GraphTraversalContext =
+    TraversalContext<typename Graph::Node, Ratio,
+                     HasDenseNodeIds<Graph>::value>;
+
+#endif  // INTERVIEW_PRACTICE_TRAVERSAL_CONTEXT_H_
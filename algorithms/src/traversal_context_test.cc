@@ -0,0 +1,95 @@
+#include "traversal_context.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+TEST(RingQueue, wrapsAndGrows) {
+  RingQueue<int> queue;
+  int next_push = 0, next_pop = 0;
+
+  // Interleave so the contents wrap around the buffer before it grows.
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      queue.push_back(next_push++);
+    }
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_EQ(next_pop++, queue.front());
+      queue.pop_front();
+    }
+  }
+  EXPECT_EQ(100, queue.size());
+  while (!queue.empty()) {
+    ASSERT_EQ(next_pop++, queue.front());
+    queue.pop_front();
+  }
+  EXPECT_EQ(next_push, next_pop);
+
+  queue.push_back(7);
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(VisitedSet, denseIds) {
+  VisitedSet<uint32_t, /*DenseIds=*/true> visited;
+  EXPECT_FALSE(visited.contains(5));
+  EXPECT_TRUE(visited.insert(5));
+  EXPECT_FALSE(visited.insert(5));
+  EXPECT_TRUE(visited.contains(5));
+  EXPECT_TRUE(visited.insert(1000));
+  EXPECT_TRUE(visited.contains(5));
+
+  EXPECT_TRUE(visited.erase(1000));
+  EXPECT_FALSE(visited.erase(1000));
+  EXPECT_FALSE(visited.contains(1000));
+  EXPECT_TRUE(visited.insert(1000));
+
+  visited.clear();
+  EXPECT_FALSE(visited.contains(5));
+  EXPECT_FALSE(visited.contains(1000));
+  EXPECT_TRUE(visited.insert(5));
+}
+
+TEST(VisitedSet, hashed) {
+  VisitedSet<std::string> visited;
+  EXPECT_TRUE(visited.insert("A"));
+  EXPECT_FALSE(visited.insert("A"));
+  EXPECT_TRUE(visited.contains("A"));
+  EXPECT_TRUE(visited.erase("A"));
+  EXPECT_FALSE(visited.erase("A"));
+  EXPECT_TRUE(visited.insert("A"));
+  visited.clear();
+  EXPECT_FALSE(visited.contains("A"));
+}
+
+// Integer nodes are hashed unless the graph opts in, so sparse IDs stay cheap.
+TEST(VisitedSet, sparseIntegerIds) {
+  VisitedSet<uint32_t> visited;
+  EXPECT_TRUE(visited.insert(1000000000));
+  EXPECT_TRUE(visited.contains(1000000000));
+  EXPECT_FALSE(visited.contains(5));
+}
+
+namespace {
+
+struct SparseGraph {
+  using Node = uint32_t;
+};
+
+struct DenseGraph {
+  using Node = uint32_t;
+  static constexpr bool kDenseNodeIds = true;
+};
+
+}  // namespace
+
+TEST(GraphTraversalContext, denseOnlyIfGraphOptsIn) {
+  static_assert(!HasDenseNodeIds<SparseGraph>::value);
+  static_assert(HasDenseNodeIds<DenseGraph>::value);
+  static_assert(std::is_same_v<GraphTraversalContext<SparseGraph>,
+                               TraversalContext<uint32_t>>);
+  static_assert(std::is_same_v<GraphTraversalContext<DenseGraph>,
+                               TraversalContext<uint32_t, double, true>>);
+}
@@ -0,0 +1,76 @@
+#ifndef __COARSE_TO_FINE_PLANNER_HH_
+#define __COARSE_TO_FINE_PLANNER_HH_
+
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+/** How a 2x2 block of cells is combined into one coarse cell. */
+enum class Pooling {
+  MAX,
+  MEAN,
+};
+
+/**
+ * Halves the resolution of costMap: coarse cell (r, c) covers cells
+ * (2r..2r+1, 2c..2c+1). Odd sizes round up, and the last row/col pool fewer
+ * cells.
+ *
+ * Only feasible cells are pooled. A coarse cell is +inf only when all its
+ * cells are, so the coarse map never blocks a route the fine map has: if
+ * there is no coarse path, there is no fine path either.
+ *
+ * Costs aren't scaled: a coarse step covers twice the distance and twice the
+ * cells, so cell cost vs distance stays balanced as in computePath.
+ */
+Map2D<float> downsampleCostMap(Map2D<float> const &costMap, Pooling pooling);
+
+/**
+ * Cost maps at 1/2, 1/4, ... the resolution of costMap: result[i] is
+ * downsampled i + 1 times. costMap itself isn't copied.
+ */
+std::vector<Map2D<float> > buildCostMapPyramid(Map2D<float> const &costMap,
+                                               int numCoarseLevels,
+                                               Pooling pooling);
+
+/**
+ * Plans on the coarsest level of a cost map pyramid, then at each finer level
+ * only inside a corridor around the coarser path.
+ *
+ * Paths are feasible and found whenever one exists, but may cost more than
+ * computePath's when the optimal path leaves the corridor. If the corridor
+ * holds no path at some level, falls back to computePath on the full map.
+ *
+ * costMap must outlive the planner. Rebuild the planner after changing costs.
+ */
+class CoarseToFinePlanner {
+ public:
+  /**
+   * numCoarseLevels = 0 is plain computePath. corridorRadius is in cells of
+   * the coarser level, around each cell of its path.
+   */
+  CoarseToFinePlanner(Map2D<float> const &costMap, int numCoarseLevels,
+                      Pooling pooling = Pooling::MEAN, int corridorRadius = 2);
+
+  /**
+   * Same interface as computePath. Coarse levels are planned 8-connected for
+   * ANY_ANGLE, since the corridor needs every cell of the coarse path.
+   */
+  double computePath(Cell start, Cell end, std::vector<Cell> &path,
+                     PlannerMode mode = PlannerMode::FOUR_CONNECTED) const;
+
+  int getNumCoarseLevels() const { return (int)levels_.size(); }
+
+  /** Level 0 is the full cost map. */
+  Map2D<float> const &getLevel(int level) const {
+    return level == 0 ? costMap_ : levels_[level - 1];
+  }
+
+ private:
+  Map2D<float> const &costMap_;
+  const std::vector<Map2D<float> > levels_;
+  const int corridorRadius_;
+};
+
+#endif  // __COARSE_TO_FINE_PLANNER_HH_
@@ -1,10 +1,48 @@
 #ifndef __DJIKSTRA_PLANNER_HH_
 #define __DJIKSTRA_PLANNER_HH_
 
+#include <limits>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "map_2d.hh"
+#include "planner_stats.hh"
+
+namespace impl {
+
+/** Store the current cost and the parent (previous node) of the cell. */
+struct CellCostAndParent {
+  double cost = std::numeric_limits<double>::infinity();
+  std::optional<Cell> parent;
+
+  CellCostAndParent() = default;
+
+  CellCostAndParent(CellCostAndParent const &other) = default;
+  CellCostAndParent &operator=(CellCostAndParent const &other) = default;
+};
+
+}  // namespace impl
+
+/**
+ * Result of an expansion: for each cell, the min cost of a path from the
+ * source(s) to the cell, and the parent (previous cell) on that path.
+ * Sources have no parent. Unreachable cells have cost +inf.
+ */
+using DistanceField = Map2D<impl::CellCostAndParent>;
+
+/** Allowed moves between cells. */
+enum class PlannerMode {
+  // Up/down and left/right moves. Travel cost is 1.0.
+  FOUR_CONNECTED,
+  // Also allows diagonal moves, with travel cost sqrt(2). Diagonal moves may
+  // not cut the corner of an infeasible cell.
+  EIGHT_CONNECTED,
+  // Theta*. Expands like EIGHT_CONNECTED, but a cell may use its grandparent
+  // as parent when there is line-of-sight between them. The returned path is
+  // the list of waypoints at the ends of each straight segment.
+  ANY_ANGLE,
+};
 
 /**
  * Computes min-cost path between start and end. Returns [] if path not found.
@@ -13,31 +51,181 @@
  *
  * pathCost = sum(costMap[r, c] for each cell) + distanceCost
  *
+ * distanceCost is the Euclidean length of the path, measured between cell
+ * centers. For ANY_ANGLE, the cells summed are the cells crossed by each
+ * straight segment (see impl::lineCost).
+ *
  * All costMap values must be >= 0.0. Infeasible points are +Inf.
+ *
+ * The search runs on costMap's layout, and so does its explored map. Defined
+ * for RowMajorLayout and TiledLayout<> (see djikstra_planner.cc).
+ */
+template <typename LayoutT>
+double computePath(Cell start, Cell end, Map2D<float, LayoutT> const &costMap,
+                   std::vector<Cell> &path,
+                   PlannerMode mode = PlannerMode::FOUR_CONNECTED,
+                   PlannerStats *stats = nullptr);
+
+/**
+ * Reusable buffers for computePath. Keeping one per thread avoids allocating a
+ * map-sized explored map for every query: reset() only clears the cells the
+ * previous query touched.
+ *
+ * LayoutT must match the layout of the cost maps it is used with.
  */
-double computePath(Cell start, Cell end, Map2D<float> const &costMap,
-                   std::vector<Cell> &path);
+template <typename LayoutT>
+struct BasicPlannerScratch {
+  BasicPlannerScratch(int width, int height) : explored(width, height) {}
+
+  /** Resets the cells touched by the previous query back to +inf. */
+  void reset();
+
+  // All +inf after reset().
+  Map2D<impl::CellCostAndParent, LayoutT> explored;
+
+  // Cells written to explored since the last reset().
+  std::vector<Cell> touched;
+
+  // Priority queue storage, kept as a min-heap on cost.
+  std::vector<std::pair<double, Cell> > heap;
+};
+
+using PlannerScratch = BasicPlannerScratch<RowMajorLayout>;
+
+/**
+ * Same as computePath, but uses scratch instead of allocating. scratch must
+ * match the size of costMap.
+ *
+ * Until the next query, scratch.explored holds the cells this query explored
+ * (ex: for saveExplorationHeatmap).
+ */
+template <typename LayoutT>
+double computePath(Cell start, Cell end, Map2D<float, LayoutT> const &costMap,
+                   std::vector<Cell> &path, PlannerMode mode,
+                   BasicPlannerScratch<LayoutT> &scratch,
+                   PlannerStats *stats = nullptr);
+
+/**
+ * Same cost and result as computePath, searching from start and end at the
+ * same time until the two searches meet. Expands about half the area of
+ * computePath on long queries through open space.
+ *
+ * The path may differ from computePath's when several paths have the min
+ * cost. ANY_ANGLE costs aren't symmetric, so it uses computePath instead.
+ */
+double computeBidirectionalPath(Cell start, Cell end,
+                                Map2D<float> const &costMap,
+                                std::vector<Cell> &path,
+                                PlannerMode mode = PlannerMode::FOUR_CONNECTED,
+                                PlannerStats *stats = nullptr);
+
+/**
+ * Expands from start over the whole map, using the same costs as computePath.
+ * Ex: a cost-to-go field for a controller.
+ *
+ * For FOUR_CONNECTED and EIGHT_CONNECTED path costs are symmetric, so this is
+ * also the cost from every cell to start.
+ */
+DistanceField computeDistanceField(
+    Cell start, Map2D<float> const &costMap,
+    PlannerMode mode = PlannerMode::FOUR_CONNECTED);
+
+/**
+ * Multi-source version: cost from the cheapest source to each cell, in a
+ * single expansion.
+ */
+DistanceField computeDistanceField(
+    std::vector<Cell> const &starts, Map2D<float> const &costMap,
+    PlannerMode mode = PlannerMode::FOUR_CONNECTED);
+
+/**
+ * Extracts the path from the field's source to end, following parents.
+ * Returns [] and +inf if end is unreachable.
+ */
+double findPathInField(DistanceField const &field, Cell end,
+                       std::vector<Cell> &path);
+
+/**
+ * Costs from start to each of ends, like computePath, sharing one expansion.
+ * The expansion stops once every end is reached, except for ANY_ANGLE (see
+ * impl::explore).
+ */
+std::vector<double> computeCosts(
+    Cell start, std::vector<Cell> const &ends, Map2D<float> const &costMap,
+    PlannerMode mode = PlannerMode::FOUR_CONNECTED);
+
+/**
+ * Cost matrix: result[i][j] is the computePath cost from starts[i] to ends[j].
+ *
+ * Runs one early-stopping expansion per start. For FOUR_CONNECTED and
+ * EIGHT_CONNECTED, costs are symmetric and it expands from the ends instead
+ * when there are fewer of them.
+ */
+std::vector<std::vector<double> > computeCostMatrix(
+    std::vector<Cell> const &starts, std::vector<Cell> const &ends,
+    Map2D<float> const &costMap,
+    PlannerMode mode = PlannerMode::FOUR_CONNECTED);
 
 namespace impl {
 
-/** Store the current cost and the parent (previous node) of the cell. */
-struct CellCostAndParent {
-  double cost = std::numeric_limits<double>::infinity();
-  std::optional<Cell> parent;
+/**
+ * Dijkstra (Theta* for ANY_ANGLE) expansion from starts into scratch.explored,
+ * which must be reset and the size of costMap.
+ *
+ * If ends is not empty, stops once all ends have been expanded. Their costs
+ * and parent chains are final at that point, so results match a full
+ * expansion. Not for ANY_ANGLE: a Theta* shortcut through a later-expanded
+ * grandparent can still lower an expanded cell's cost, so ANY_ANGLE always
+ * expands everything reachable.
+ */
+template <typename LayoutT>
+void explore(std::vector<Cell> const &starts, std::vector<Cell> const &ends,
+             Map2D<float, LayoutT> const &costMap, PlannerMode mode,
+             BasicPlannerScratch<LayoutT> &scratch,
+             PlannerStats *stats = nullptr);
 
-  CellCostAndParent() = default;
+/** Up to 8 neighbors, stored inline so expanding a cell doesn't allocate. */
+class NeighborList {
+ public:
+  void push_back(int row, int col) {
+    rows_[size_] = row;
+    cols_[size_] = col;
+    ++size_;
+  }
 
-  CellCostAndParent(CellCostAndParent const &other) = default;
-  CellCostAndParent &operator=(CellCostAndParent const &other) = default;
+  int size() const { return size_; }
+  Cell operator[](int i) const { return Cell(rows_[i], cols_[i]); }
+
+ private:
+  int rows_[8], cols_[8];
+  int size_ = 0;
 };
 
+/** Euclidean distance between the centers of two cells. */
+double travelCost(Cell from, Cell to);
+
+/**
+ * Cost of moving in a straight line from the center of `from` to the center of
+ * `to`: travelCost(from, to) plus the cost of every cell crossed by the
+ * segment, excluding `from`.
+ *
+ * When the segment passes exactly through a cell corner, the two cells
+ * touching that corner must be feasible, but their cost is not added. This
+ * matches the EIGHT_CONNECTED cost of a diagonal move.
+ *
+ * Returns +inf if any crossed cell is infeasible (no line-of-sight).
+ */
+template <typename LayoutT>
+double lineCost(Map2D<float, LayoutT> const &costMap, Cell from, Cell to);
+
 /** Finds path from start -> end using exploredMap.
-o *
+ *
  * Returns empty path and +inf if no path found.
  */
-double findPathFromExploration(Cell start, Cell end,
-                               Map2D<CellCostAndParent> const &exploredMap,
-                               std::vector<Cell> &path);
+template <typename LayoutT>
+double findPathFromExploration(
+    Cell start, Cell end, Map2D<CellCostAndParent, LayoutT> const &exploredMap,
+    std::vector<Cell> &path);
 
 }  // namespace impl
 
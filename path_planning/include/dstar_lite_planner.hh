@@ -0,0 +1,84 @@
+#ifndef __DSTAR_LITE_PLANNER_HH_
+#define __DSTAR_LITE_PLANNER_HH_
+
+#include <limits>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+#include "planner_stats.hh"
+
+/**
+ * Incremental planner (D* Lite) for a fixed goal.
+ *
+ * Keeps its search state between calls. After cost changes (updateCell) or a
+ * new start (setStart), computePath only repairs the part of the search that
+ * the change affects, instead of rerunning computePath from scratch.
+ *
+ * Uses the same cost model as computePath (4-connected), and returns the same
+ * optimal cost. The planner keeps its own copy of the cost map.
+ */
+class DStarLitePlanner {
+ public:
+  DStarLitePlanner(Map2D<float> const &costMap, Cell start, Cell end);
+
+  /**
+   * Repairs the search and returns the min-cost path from start to end.
+   * Returns [] and +inf if no path exists.
+   */
+  double computePath(std::vector<Cell> &path, PlannerStats *stats = nullptr);
+
+  /** Changes the cost of one cell. Takes effect at the next computePath. */
+  void updateCell(Cell cell, float cost);
+
+  /** Moves the start (ex: the vehicle moved along the path). */
+  void setStart(Cell start);
+
+  Map2D<float> const &getCostMap() const { return costMap_; }
+
+ private:
+  struct CellState {
+    // Cost-to-goal, and its one-step lookahead.
+    double g = std::numeric_limits<double>::infinity();
+    double rhs = std::numeric_limits<double>::infinity();
+
+    // Key while in the queue.
+    bool queued = false;
+    double key1 = 0.0, key2 = 0.0;
+  };
+
+  // (key1, key2, cell index)
+  using QueueEntry = std::tuple<double, double, int>;
+
+  double heuristic(Cell cell) const;
+
+  /** Cost of moving from a neighbor into cell. */
+  double edgeCost(Cell cell) const;
+
+  void updateVertex(Cell cell, PlannerStats *stats);
+  void computeShortestPath(PlannerStats *stats);
+
+  int cellIndex(Cell cell) const {
+    return cell.row * costMap_.getWidth() + cell.col;
+  }
+  Cell indexCell(int index) const {
+    return Cell(index / costMap_.getWidth(), index % costMap_.getWidth());
+  }
+
+  /** Appends the valid 4-connected neighbors of cell. */
+  void getNeighbors(Cell cell, impl::NeighborList &neighbors) const;
+
+  Map2D<float> costMap_;
+  Cell start_, end_;
+
+  // Heuristic offset from start moves.
+  double km_ = 0.0;
+  Cell lastStart_;
+
+  Map2D<CellState> states_;
+  std::set<QueueEntry> queue_;
+};
+
+#endif  // __DSTAR_LITE_PLANNER_HH_
@@ -0,0 +1,94 @@
+#ifndef __DYNAMIC_COST_MAP_HH_
+#define __DYNAMIC_COST_MAP_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "map_2d.hh"
+
+/**
+ * Cost map updated by one writer while planners read consistent snapshots.
+ *
+ * Each update publishes a new immutable snapshot. Readers take the latest one
+ * with getSnapshot(), without locking, and plan on snapshot->map for as long
+ * as they hold it; later updates never change it.
+ *
+ * The map is split into square tiles to track changes. Snapshots are full
+ * row-major maps, so every planner can use them directly. Their buffers are
+ * pooled: an update rewrites a retired snapshot that no reader holds, copying
+ * only the tiles changed since it was published. The whole map is copied only
+ * to grow the pool, when readers hold every retired snapshot, so the pool is
+ * as large as the most snapshots held at once, plus one.
+ */
+class DynamicCostMap {
+ public:
+  struct Snapshot {
+    Map2D<float> map;
+
+    // Starts at 0, +1 per update.
+    uint64_t version = 0;
+
+    // Tiles are row-major, tileSize cells per side (smaller at the edges).
+    int tile_size;
+    int tiles_per_row;
+
+    // Version of the last update that changed each tile.
+    std::vector<uint64_t> tile_versions;
+
+    Snapshot(Map2D<float> const &_map, int _tileSize);
+
+    /** Tiles changed by updates after sinceVersion, in increasing order. */
+    std::vector<int> getChangedTiles(uint64_t sinceVersion) const;
+
+    /** Inclusive top-left and exclusive bottom-right cells of tile. */
+    std::pair<Cell, Cell> getTileBounds(int tile) const;
+
+    /** Tile holding cell. */
+    int getTile(Cell cell) const {
+      return (cell.row / tile_size) * tiles_per_row + cell.col / tile_size;
+    }
+  };
+
+  explicit DynamicCostMap(Map2D<float> const &initial, int tileSize = 64);
+
+  /** Latest snapshot. Safe to call from any thread. */
+  std::shared_ptr<const Snapshot> getSnapshot() const;
+
+  /**
+   * Sets the costs of cells and publishes them as one new snapshot. Returns
+   * its version.
+   *
+   * Only one thread may call update().
+   */
+  uint64_t update(std::vector<std::pair<Cell, float> > const &changes);
+
+ private:
+  // A snapshot and whether any reader (or published_) holds a lease on it.
+  struct Buffer {
+    std::shared_ptr<Snapshot> snapshot;
+    std::shared_ptr<std::atomic<bool> > in_use;
+  };
+
+  /**
+   * Reference to buffer's snapshot for readers. Marks it in use until the
+   * reference and all its copies are gone.
+   */
+  static std::shared_ptr<const Snapshot> lease(Buffer const &buffer);
+
+  /** Removes and returns the newest spare no reader holds, if any. */
+  std::optional<Buffer> takeFreeSpare();
+
+  // The latest snapshot. current_ is the writer's handle on it; published_ is
+  // its lease, read by getSnapshot() with atomic loads.
+  Buffer current_;
+  std::shared_ptr<const Snapshot> published_;
+
+  // Retired snapshots, rewritten by later updates once no reader holds them.
+  std::vector<Buffer> spares_;
+};
+
+#endif  // __DYNAMIC_COST_MAP_HH_
@@ -0,0 +1,24 @@
+#ifndef __EXPLORATION_HEATMAP_HH_
+#define __EXPLORATION_HEATMAP_HH_
+
+#include <string>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+/**
+ * Writes the region a search explored as a binary PPM image, one pixel per
+ * cell (row 0 at the top).
+ *
+ * Explored cells are shaded blue (cheapest) to red (most expensive explored
+ * cost). Unexplored cells are white, and infeasible cells in costMap are
+ * black, so a query that floods the whole map stands out.
+ *
+ * explored is the field left by a search, ex: PlannerScratch::explored after
+ * computePath. Returns false on I/O error.
+ */
+bool saveExplorationHeatmap(std::string const &path,
+                            DistanceField const &explored,
+                            Map2D<float> const &costMap);
+
+#endif  // __EXPLORATION_HEATMAP_HH_
@@ -0,0 +1,158 @@
+#ifndef __HIERARCHICAL_PLANNER_HH_
+#define __HIERARCHICAL_PLANNER_HH_
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+/**
+ * HPA* (hierarchical path-finding) over a mostly static cost map.
+ *
+ * The map is split into square clusters. Open cells on both sides of a
+ * cluster border are grouped in runs, and each run gets entrance pairs at both
+ * ends and every entranceSpacing cells (short runs get one in the middle).
+ * Costs between every pair of entrances inside a cluster are precomputed. A
+ * query searches this small abstract graph, then refines each abstract edge
+ * with a search restricted to one cluster.
+ *
+ * Uses the same cost model as computePath (4-connected). Paths are feasible
+ * and found whenever one exists, but may cost more than optimal, since borders
+ * can only be crossed at entrances. entranceSpacing = 1 makes every border
+ * cell an entrance, which is optimal but slower to build and query.
+ *
+ * costMap must outlive the planner. After changing costs, call updateCells()
+ * with the changed cells.
+ */
+class HierarchicalPlanner {
+ public:
+  /** entranceSpacing <= 0 uses clusterSize (classic HPA*). */
+  HierarchicalPlanner(Map2D<float> const &costMap, int clusterSize,
+                      int entranceSpacing = 0);
+
+  /**
+   * Reusable buffers for computePath. Keeping one per thread avoids
+   * allocating the abstract graph nodes and the cluster-sized explored maps
+   * for every query. Stays valid across updateCells().
+   */
+  struct Scratch {
+    explicit Scratch(HierarchicalPlanner const &planner);
+
+    // Abstract graph nodes, indexed by node ID (see computePath).
+    struct Node {
+      double cost = std::numeric_limits<double>::infinity();
+      std::optional<Cell> parent;
+    };
+    std::vector<Node> nodes;
+
+    // Node IDs written to nodes by the previous query.
+    std::vector<int> touched;
+
+    std::vector<Cell> abstract_path;
+
+    // Priority queue storage for the abstract and in-cluster searches, kept
+    // as min-heaps on cost.
+    std::vector<std::pair<double, Cell> > heap;
+    std::vector<std::pair<double, Cell> > cluster_heap;
+
+    // clusterSize x clusterSize; only the cluster's own extent is used.
+    Map2D<impl::CellCostAndParent> start_explored;
+    Map2D<impl::CellCostAndParent> end_explored;
+    Map2D<impl::CellCostAndParent> refine_explored;
+  };
+
+  /** Same interface as computePath. Returns [] and +inf if no path exists. */
+  double computePath(Cell start, Cell end, std::vector<Cell> &path) const;
+
+  /** Same as above, but uses scratch instead of allocating. */
+  double computePath(Cell start, Cell end, std::vector<Cell> &path,
+                     Scratch &scratch) const;
+
+  /**
+   * Rebuilds the clusters affected by cost changes in cells: the cluster of
+   * each cell, plus the cluster across the border for cells on a border.
+   *
+   * Returns the number of clusters rebuilt.
+   */
+  int updateCells(std::vector<Cell> const &cells);
+
+  int getNumClusters() const { return (int)clusters_.size(); }
+
+  /** Number of entrance cells in the abstract graph. */
+  int getNumEntrances() const { return entranceOffsets_.back(); }
+
+ private:
+  struct Cluster {
+    // Inclusive top-left corner, exclusive bottom-right corner.
+    int row_begin, col_begin, row_end, col_end;
+
+    // Entrance cells inside this cluster.
+    std::vector<Cell> entrances;
+
+    // costs[i * entrances.size() + j]: cost from entrances[i] to entrances[j]
+    // staying inside the cluster. +inf if not connected.
+    std::vector<double> costs;
+
+    // crossings[i]: cells across a border from entrances[i], in the order
+    // right, bottom, left, top.
+    std::vector<std::vector<Cell> > crossings;
+
+    bool contains(Cell cell) const {
+      return cell.row >= row_begin && cell.row < row_end &&
+             cell.col >= col_begin && cell.col < col_end;
+    }
+  };
+
+  // Open cell pairs crossing a cluster border. first is in the top/left
+  // cluster.
+  using Border = std::vector<std::pair<Cell, Cell> >;
+
+  int clusterIndex(Cell cell) const;
+
+  /**
+   * Abstract graph node of cell: its entrance ID if cell is an entrance,
+   * otherwise getNumEntrances() for start and getNumEntrances() + 1 for end.
+   */
+  int nodeId(Cell cell, Cell start) const;
+
+  /** Recomputes entranceOffsets_ after clusters were (re)built. */
+  void indexEntrances();
+
+  /** Border between cluster (r, c) and the cluster right of/below it. */
+  Border &rightBorder(int cluster_row, int cluster_col);
+  Border &bottomBorder(int cluster_row, int cluster_col);
+  Border const &rightBorder(int cluster_row, int cluster_col) const;
+  Border const &bottomBorder(int cluster_row, int cluster_col) const;
+
+  void buildBorder(int cluster_row, int cluster_col, bool right);
+  void buildCluster(int cluster_row, int cluster_col);
+
+  /**
+   * Appends the min-cost path inside the cluster from start to end, without
+   * start. end must be reachable.
+   */
+  void refineInCluster(Cluster const &cluster, Cell start, Cell end,
+                       std::vector<Cell> &path, Scratch &scratch) const;
+
+  Map2D<float> const &costMap_;
+  const int clusterSize_;
+  const int entranceSpacing_;
+  const int clusterRows_, clusterCols_;
+
+  std::vector<Cluster> clusters_;  // row-major
+  std::vector<Border> rightBorders_;
+  std::vector<Border> bottomBorders_;
+
+  // Index of each entrance cell in its cluster's entrances, -1 for other
+  // cells.
+  Map2D<int> entranceIndex_;
+
+  // Entrance IDs of clusters_[i] start at entranceOffsets_[i]; the last entry
+  // is the total number of entrances.
+  std::vector<int> entranceOffsets_;
+};
+
+#endif  // __HIERARCHICAL_PLANNER_HH_
@@ -0,0 +1,66 @@
+#ifndef __JUMP_POINT_PLANNER_HH_
+#define __JUMP_POINT_PLANNER_HH_
+
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+#include "planner_stats.hh"
+
+/**
+ * Finds a path of the same cost as
+ * computePath(..., PlannerMode::EIGHT_CONNECTED), using A* with Jump Point
+ * Search. Ties between equal-cost paths may be broken differently.
+ *
+ * Inside uniform-cost regions the search "jumps" along straight lines and only
+ * pushes cells where the path may turn. A cell with an open neighbor of a
+ * different cost is always a jump point and, like the start, is expanded in
+ * all 8 directions, so weighted areas fall back to regular A* expansion.
+ *
+ * Cells next to an obstacle or the map border are not expanded in all
+ * directions; they use forced-neighbor pruning instead. Every other cell only
+ * continues in the direction it was reached from, plus that direction's two
+ * straight components for a diagonal. A straight move also turns (straight and
+ * diagonally) towards each open side cell whose cell behind is blocked or off
+ * the map.
+ *
+ * Returns every cell on the path, like computePath. Returns [] and +inf if no
+ * path is found.
+ */
+double computeJumpPointPath(Cell start, Cell end, Map2D<float> const &costMap,
+                            std::vector<Cell> &path,
+                            PlannerStats *stats = nullptr);
+
+/**
+ * Cheapest cell cost in costMap, which the JPS heuristic adds for every cell
+ * entered. +inf if every cell is blocked.
+ */
+float minCellCost(Map2D<float> const &costMap);
+
+/**
+ * Same as computeJumpPointPath, for many queries on one map: minCost is
+ * minCellCost(costMap), computed once, and scratch (matching the size of
+ * costMap) is used instead of allocating.
+ */
+double computeJumpPointPath(Cell start, Cell end, Map2D<float> const &costMap,
+                            std::vector<Cell> &path, float minCost,
+                            PlannerScratch &scratch,
+                            PlannerStats *stats = nullptr);
+
+namespace impl {
+
+/**
+ * Same search as computeJumpPointPath, but without jumping: plain 8-connected
+ * A* with an octile heuristic. Baseline for JPS.
+ */
+double computeAStarPath(Cell start, Cell end, Map2D<float> const &costMap,
+                        std::vector<Cell> &path,
+                        PlannerStats *stats = nullptr);
+double computeAStarPath(Cell start, Cell end, Map2D<float> const &costMap,
+                        std::vector<Cell> &path, float minCost,
+                        PlannerScratch &scratch,
+                        PlannerStats *stats = nullptr);
+
+}  // namespace impl
+
+#endif  // __JUMP_POINT_PLANNER_HH_
@@ -0,0 +1,58 @@
+#ifndef __LANDMARK_PLANNER_HH_
+#define __LANDMARK_PLANNER_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+#include "planner_stats.hh"
+
+/**
+ * A* with ALT (landmark) heuristics, for many queries on a static map.
+ *
+ * The constructor picks landmarks by farthest-point selection and stores a
+ * computeDistanceField cost from each landmark to every cell. For a landmark
+ * L with field f, where c is the cell cost, the triangle inequality gives two
+ * lower bounds on the remaining cost from v to goal g:
+ *
+ *   f(g) - f(v)    and    f(v) - f(g) - c(v) + c(g)
+ *
+ * The heuristic is the max over landmarks, and is consistent. More landmarks
+ * give tighter bounds and fewer expansions, at 8 bytes per cell each.
+ *
+ * mode must be FOUR_CONNECTED or EIGHT_CONNECTED (costs must be symmetric).
+ * costMap must outlive the planner. Rebuild the planner after changing costs.
+ */
+class LandmarkPlanner {
+ public:
+  LandmarkPlanner(Map2D<float> const &costMap, int numLandmarks,
+                  PlannerMode mode = PlannerMode::FOUR_CONNECTED);
+
+  /** Same result as computePath. Returns [] and +inf if no path exists. */
+  double computePath(Cell start, Cell end, std::vector<Cell> &path,
+                     PlannerStats *stats = nullptr) const;
+
+  /** Lower bound on the cost from cell to end, excluding cell's own cost. */
+  double heuristic(Cell cell, Cell end) const;
+
+  std::vector<Cell> const &getLandmarks() const { return landmarks_; }
+
+  /** Size of the landmark distance tables. */
+  size_t getMemoryBytes() const;
+
+ private:
+  int index(Cell cell) const {
+    return cell.row * costMap_.getWidth() + cell.col;
+  }
+
+  Map2D<float> const &costMap_;
+  const PlannerMode mode_;
+
+  std::vector<Cell> landmarks_;
+
+  // fields_[i][index(cell)]: cost from landmarks_[i] to cell.
+  std::vector<std::vector<double> > fields_;
+};
+
+#endif  // __LANDMARK_PLANNER_HH_
@@ -1,7 +1,9 @@
 #ifndef __MAP_2D_HH_
 #define __MAP_2D_HH_
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <vector>
 
 // Row/col coordinates of cell.
@@ -21,41 +23,145 @@ struct Cell {
   bool operator!=(Cell const &other) const { return !(*this == other); }
 };
 
-/** Obstacles and costs arrayed on 2D map. */
-template <typename ValueT>
+/** Plain row-major storage. */
+class RowMajorLayout {
+ public:
+  RowMajorLayout(int width, int height) : width_(width), height_(height) {}
+
+  /** Number of stored values. */
+  int size() const { return width_ * height_; }
+
+  int index(int row, int col) const { return row * width_ + col; }
+
+ private:
+  int width_, height_;
+};
+
+/**
+ * Square tiles of 2^TileBits cells per side. Tiles are stored row-major, and
+ * cells row-major within each tile, so up/down neighbors are usually in the
+ * same tile instead of a full map row away.
+ *
+ * The map is padded to a whole number of tiles.
+ */
+template <int TileBits = 3>
+class TiledLayout {
+ public:
+  TiledLayout(int width, int height)
+      : tiles_per_row_((width + kTileMask) >> TileBits),
+        tile_rows_((height + kTileMask) >> TileBits) {}
+
+  int size() const { return (tiles_per_row_ * tile_rows_) << (2 * TileBits); }
+
+  int index(int row, int col) const {
+    const int tile = (row >> TileBits) * tiles_per_row_ + (col >> TileBits);
+    return (tile << (2 * TileBits)) | ((row & kTileMask) << TileBits) |
+           (col & kTileMask);
+  }
+
+ private:
+  static constexpr int kTileMask = (1 << TileBits) - 1;
+
+  int tiles_per_row_, tile_rows_;
+};
+
+/**
+ * Obstacles and costs arrayed on 2D map.
+ *
+ * LayoutT maps cells to storage indices (see RowMajorLayout). It only affects
+ * memory locality; the interface is the same for every layout.
+ *
+ * Values are either owned by the map, or in external storage (ex: a
+ * memory-mapped file, see loadMapFile).
+ */
+template <typename ValueT, typename LayoutT = RowMajorLayout>
 class Map2D {
  public:
   Map2D(int width, int height)
-      : Map2D(width, height, std::vector<ValueT>(width * height)) {}
+      : width_(width),
+        height_(height),
+        layout_(width, height),
+        values_(layout_.size()),
+        data_(values_.data()) {
+    assert(width_ > 0);
+    assert(height_ > 0);
+  }
 
+  /** values are packed row major, whatever the layout. */
   Map2D(int width, int height, std::vector<ValueT> const &values)
-      : width_(width), height_(height), values_(values) {
+      : Map2D(width, height) {
     assert((int)values.size() == width_ * height_);
+    for (int row = 0; row < height_; ++row) {
+      for (int col = 0; col < width_; ++col) {
+        values_[layout_.index(row, col)] = values[row * width_ + col];
+      }
+    }
+  }
+
+  /**
+   * Uses external storage without copying. external holds the values in
+   * layout order, and is kept alive as long as the map uses it. To share the
+   * storage between maps, construct each one from the same pointer; copies of
+   * the map own their values.
+   */
+  Map2D(int width, int height, std::shared_ptr<ValueT> const &external)
+      : width_(width),
+        height_(height),
+        layout_(width, height),
+        external_(external),
+        data_(external_.get()) {
     assert(width_ > 0);
     assert(height_ > 0);
   }
 
-  void fill(ValueT value) { std::fill(values_.begin(), values_.end(), value); }
+  /** Always a deep copy, even of a map with external storage. */
+  Map2D(Map2D const &other)
+      : width_(other.width_),
+        height_(other.height_),
+        layout_(other.layout_),
+        values_(other.data_, other.data_ + other.size()),
+        data_(values_.data()) {}
+
+  Map2D(Map2D &&other)
+      : width_(other.width_),
+        height_(other.height_),
+        layout_(other.layout_),
+        values_(std::move(other.values_)),
+        external_(std::move(other.external_)),
+        data_(external_ ? external_.get() : values_.data()) {}
+
+  void fill(ValueT value) { std::fill(data_, data_ + layout_.size(), value); }
 
   int getWidth() const { return width_; }
   int getHeight() const { return height_; }
 
   /** Returns cost for cell. Crashes for out-of-bounds values. */
-  ValueT const &getCost(Cell cell) const { return values_[computeIndex(cell)]; }
+  ValueT const &getCost(Cell cell) const { return data_[computeIndex(cell)]; }
 
   /** Sets cost for cell. Crashes for out-of-bounds values. */
-  ValueT &getCost(Cell cell) { return values_[computeIndex(cell)]; }
+  ValueT &getCost(Cell cell) { return data_[computeIndex(cell)]; }
+
+  /** All stored values, in layout order. */
+  ValueT const *data() const { return data_; }
+  int size() const { return layout_.size(); }
 
  private:
   int computeIndex(Cell cell) const {
     assert(cell.row >= 0 && cell.row < height_);
     assert(cell.col >= 0 && cell.col < width_);
 
-    return cell.row * width_ + cell.col;
+    return layout_.index(cell.row, cell.col);
   }
 
   const int width_, height_;
+  const LayoutT layout_;
+
+  // Exactly one of these holds the values.
   std::vector<ValueT> values_;
+  std::shared_ptr<ValueT> external_;
+
+  // Points into values_ or external_.
+  ValueT *data_;
 };
 
 #endif  // __MAP_2D_HH_
@@ -0,0 +1,37 @@
+#ifndef __MAP_FILE_HH_
+#define __MAP_FILE_HH_
+
+#include <optional>
+#include <string>
+
+#include "map_2d.hh"
+
+/**
+ * Binary cost map files.
+ *
+ * Format (native byte order): a 32 byte header, then width * height floats
+ * packed row major.
+ *
+ *   char    magic[8]    "MAP2DF32"
+ *   int32   version     1
+ *   int32   width
+ *   int32   height
+ *   char    reserved[12]
+ */
+
+/** Writes costMap to path. Returns false on I/O error. */
+bool saveMapFile(std::string const &path, Map2D<float> const &costMap);
+
+/**
+ * Memory-maps a file written by saveMapFile. Nothing is copied: pages are read
+ * on first access, and processes mapping the same file share them.
+ *
+ * The mapping is read-only, so the map is const. Copy it to change costs; the
+ * copy owns its values.
+ *
+ * Returns nullopt if the file can't be opened or isn't a valid map file, or if
+ * it has more than INT_MAX cells, which Map2D can't index.
+ */
+std::optional<const Map2D<float> > loadMapFile(std::string const &path);
+
+#endif  // __MAP_FILE_HH_
@@ -0,0 +1,29 @@
+#ifndef __PATH_SIMPLIFIER_HH_
+#define __PATH_SIMPLIFIER_HH_
+
+#include <vector>
+
+#include "map_2d.hh"
+
+/**
+ * Drops the cells in the middle of straight runs, keeping the first and last
+ * cells and every turn. Lossless: the straight segments between the kept
+ * waypoints cross the same cells (see impl::lineCost).
+ */
+std::vector<Cell> compressCollinear(std::vector<Cell> const &path);
+
+/**
+ * String pulling: replaces runs of path with straight segments, as long as
+ * each segment's impl::lineCost is at most (1 + maxRelativeIncrease) times
+ * the cost of the part of path it replaces. The total cost then grows by at
+ * most that factor too. 0 only takes shortcuts that cost no more.
+ *
+ * path is any path from a planner: every cell, or ANY_ANGLE waypoints.
+ * Returns the cost of the waypoints, measured like ANY_ANGLE computePath
+ * (first cell cost, plus lineCost of each segment). Returns +inf and [] if
+ * path is empty.
+ */
+double simplifyPath(std::vector<Cell> const &path, Map2D<float> const &costMap,
+                    double maxRelativeIncrease, std::vector<Cell> &waypoints);
+
+#endif  // __PATH_SIMPLIFIER_HH_
@@ -0,0 +1,38 @@
+#ifndef __PLANNER_STATS_HH_
+#define __PLANNER_STATS_HH_
+
+#include <cstddef>
+
+/**
+ * Optional counters filled in by planners. Pass nullptr to skip.
+ *
+ * Not every planner fills in every counter; each one lists who does. The rest
+ * stay 0.
+ */
+struct PlannerStats {
+  // Entries pushed onto / popped from the priority queue. Every planner.
+  size_t heap_pushes = 0;
+  size_t heap_pops = 0;
+
+  // Popped entries that were expanded (not stale). Every planner.
+  size_t expansions = 0;
+
+  // Neighbor costs computed while expanding, whether or not they improved
+  // the neighbor. computePath, computeBidirectionalPath and
+  // LandmarkPlanner::computePath.
+  size_t relaxations = 0;
+
+  // Max number of entries in the priority queue(s) at once. computePath and
+  // computeBidirectionalPath.
+  size_t heap_peak_size = 0;
+
+  // Wall time searching, and extracting the path afterwards. computePath and
+  // computeBidirectionalPath.
+  double search_ms = 0.0;
+  double path_ms = 0.0;
+
+  /** Popped entries skipped because the cell had a lower cost already. */
+  size_t stalePops() const { return heap_pops - expansions; }
+};
+
+#endif  // __PLANNER_STATS_HH_
@@ -0,0 +1,59 @@
+#ifndef __PLANNING_SERVICE_HH_
+#define __PLANNING_SERVICE_HH_
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+/** One computePath request. */
+struct PathQuery {
+  Cell start;
+  Cell end;
+  PlannerMode mode = PlannerMode::FOUR_CONNECTED;
+
+  PathQuery(Cell _start, Cell _end,
+            PlannerMode _mode = PlannerMode::FOUR_CONNECTED)
+      : start(_start), end(_end), mode(_mode) {}
+};
+
+/** computePath output for one query. */
+struct PathResult {
+  double cost = std::numeric_limits<double>::infinity();
+  std::vector<Cell> path;
+};
+
+/**
+ * Runs batches of computePath queries in parallel against one cost map.
+ *
+ * Each worker keeps its own PlannerScratch across queries and batches, so
+ * queries don't allocate a map-sized explored map. Workers only read costMap.
+ *
+ * costMap must outlive the service and must not change during
+ * computePaths(). A service runs one batch at a time: don't call
+ * computePaths() concurrently on the same service.
+ */
+class PlanningService {
+ public:
+  /** numWorkers <= 0 uses std::thread::hardware_concurrency(). */
+  PlanningService(Map2D<float> const &costMap, int numWorkers = 0);
+
+  /**
+   * Results are in the same order as queries, and match computePath for each
+   * query.
+   */
+  std::vector<PathResult> computePaths(std::vector<PathQuery> const &queries);
+
+  int getNumWorkers() const { return (int)scratches_.size(); }
+
+ private:
+  Map2D<float> const &costMap_;
+
+  // One per worker. Pointers, since scratch is large and workers write to
+  // their own while others run.
+  std::vector<std::unique_ptr<PlannerScratch> > scratches_;
+};
+
+#endif  // __PLANNING_SERVICE_HH_
@@ -0,0 +1,168 @@
+#include "coarse_to_fine_planner.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+/** Cell containing cell, levels coarser. */
+Cell toLevel(Cell cell, int levels) {
+  return Cell(cell.row >> levels, cell.col >> levels);
+}
+
+/**
+ * Min-cost path from start to end on map, only through the children of cells
+ * within radius of coarsePath (one level coarser). Returns +inf if the
+ * corridor holds no path.
+ */
+double computePathInCorridor(Cell start, Cell end, Map2D<float> const &map,
+                             std::vector<Cell> const &coarsePath, int radius,
+                             std::vector<Cell> &path, PlannerMode mode) {
+  // Corridor bounds at the coarse level, inclusive.
+  int row_min = coarsePath[0].row, row_max = row_min;
+  int col_min = coarsePath[0].col, col_max = col_min;
+  for (const Cell cell : coarsePath) {
+    row_min = std::min(row_min, cell.row);
+    row_max = std::max(row_max, cell.row);
+    col_min = std::min(col_min, cell.col);
+    col_max = std::max(col_max, cell.col);
+  }
+  row_min = std::max(0, row_min - radius);
+  col_min = std::max(0, col_min - radius);
+  row_max += radius;
+  col_max += radius;
+
+  Map2D<char> corridor(col_max - col_min + 1, row_max - row_min + 1);
+  for (const Cell cell : coarsePath) {
+    for (int r = cell.row - radius; r <= cell.row + radius; ++r) {
+      for (int c = cell.col - radius; c <= cell.col + radius; ++c) {
+        if (r >= row_min && c >= col_min) {
+          corridor.getCost(Cell(r - row_min, c - col_min)) = 1;
+        }
+      }
+    }
+  }
+
+  // Local map over the corridor bounds at this level; +inf outside corridor.
+  const Cell origin(2 * row_min, 2 * col_min);
+  const int height = std::min(map.getHeight(), 2 * (row_max + 1)) - origin.row;
+  const int width = std::min(map.getWidth(), 2 * (col_max + 1)) - origin.col;
+  Map2D<float> local_map(width, height);
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const bool inside =
+          corridor.getCost(Cell((origin.row + row) / 2 - row_min,
+                                (origin.col + col) / 2 - col_min));
+      local_map.getCost(Cell(row, col)) =
+          inside ? map.getCost(Cell(origin.row + row, origin.col + col)) : INF;
+    }
+  }
+
+  std::vector<Cell> local_path;
+  const double cost =
+      computePath(Cell(start.row - origin.row, start.col - origin.col),
+                  Cell(end.row - origin.row, end.col - origin.col), local_map,
+                  local_path, mode);
+  for (const Cell cell : local_path) {
+    path.push_back(Cell(cell.row + origin.row, cell.col + origin.col));
+  }
+  return cost;
+}
+
+}  // namespace
+
+Map2D<float> downsampleCostMap(Map2D<float> const &costMap, Pooling pooling) {
+  const int width = (costMap.getWidth() + 1) / 2;
+  const int height = (costMap.getHeight() + 1) / 2;
+  Map2D<float> result(width, height);
+
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      float max_cost = 0.0, total_cost = 0.0;
+      int num_feasible = 0;
+      for (int r = 2 * row; r < std::min(2 * row + 2, costMap.getHeight());
+           ++r) {
+        for (int c = 2 * col; c < std::min(2 * col + 2, costMap.getWidth());
+             ++c) {
+          const float cost = costMap.getCost(Cell(r, c));
+          if (std::isinf(cost)) {
+            continue;
+          }
+          max_cost = std::max(max_cost, cost);
+          total_cost += cost;
+          ++num_feasible;
+        }
+      }
+
+      float &value = result.getCost(Cell(row, col));
+      if (num_feasible == 0) {
+        value = INF;
+      } else if (pooling == Pooling::MAX) {
+        value = max_cost;
+      } else {
+        value = total_cost / num_feasible;
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<Map2D<float> > buildCostMapPyramid(Map2D<float> const &costMap,
+                                               int numCoarseLevels,
+                                               Pooling pooling) {
+  std::vector<Map2D<float> > levels;
+  levels.reserve(numCoarseLevels);
+  for (int level = 0; level < numCoarseLevels; ++level) {
+    levels.push_back(downsampleCostMap(
+        level == 0 ? costMap : levels.back(), pooling));
+  }
+  return levels;
+}
+
+CoarseToFinePlanner::CoarseToFinePlanner(Map2D<float> const &costMap,
+                                         int numCoarseLevels, Pooling pooling,
+                                         int corridorRadius)
+    : costMap_(costMap),
+      levels_(buildCostMapPyramid(costMap, numCoarseLevels, pooling)),
+      corridorRadius_(corridorRadius) {}
+
+double CoarseToFinePlanner::computePath(Cell start, Cell end,
+                                        std::vector<Cell> &path,
+                                        PlannerMode mode) const {
+  path.clear();
+  const int top = getNumCoarseLevels();
+  if (top == 0) {
+    return ::computePath(start, end, costMap_, path, mode);
+  }
+
+  const PlannerMode coarse_mode =
+      mode == PlannerMode::ANY_ANGLE ? PlannerMode::EIGHT_CONNECTED : mode;
+
+  // The coarse map never blocks a fine route, so no coarse path is final.
+  std::vector<Cell> coarse_path;
+  if (std::isinf(::computePath(toLevel(start, top), toLevel(end, top),
+                               getLevel(top), coarse_path, coarse_mode))) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  for (int level = top - 1; level > 0; --level) {
+    std::vector<Cell> level_path;
+    if (std::isinf(computePathInCorridor(
+            toLevel(start, level), toLevel(end, level), getLevel(level),
+            coarse_path, corridorRadius_, level_path, coarse_mode))) {
+      return ::computePath(start, end, costMap_, path, mode);
+    }
+    coarse_path.swap(level_path);
+  }
+
+  const double cost = computePathInCorridor(start, end, costMap_, coarse_path,
+                                            corridorRadius_, path, mode);
+  if (std::isinf(cost)) {
+    path.clear();
+    return ::computePath(start, end, costMap_, path, mode);
+  }
+  return cost;
+}
@@ -1,102 +1,463 @@
 #include "djikstra_planner.hh"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <queue>
+#include <cstdlib>
+#include <unordered_map>
 #include <utility>
 
 #include "map_2d.hh"
 
 namespace {
 
-/** Returns valid neighbors in up/down and left/right directions. */
-std::vector<Cell> getNeighbors(Map2D<float> const &costMap, Cell start) {
-  std::vector<Cell> result;
-  static const int dr[] = {-1, 1, 0, 0};
-  static const int dc[] = {0, 0, -1, 1};
-  for (int i = 0; i < 4; ++i) {
+template <typename LayoutT>
+bool isFeasible(Map2D<float, LayoutT> const &costMap, int row, int col) {
+  return !std::isinf(costMap.getCost(Cell(row, col)));
+}
+
+/**
+ * Returns valid neighbors in up/down and left/right directions, plus diagonals
+ * if the mode allows them.
+ *
+ * A diagonal neighbor is only valid if both cells sharing its corner with
+ * start are feasible.
+ */
+template <typename LayoutT>
+void getNeighbors(Map2D<float, LayoutT> const &costMap, Cell start,
+                  PlannerMode mode, impl::NeighborList &result) {
+  static const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+  static const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+  const int num_directions = mode == PlannerMode::FOUR_CONNECTED ? 4 : 8;
+
+  // Interior cells have all neighbors in bounds: one check for all of them.
+  const bool interior = start.row > 0 && start.row < costMap.getHeight() - 1 &&
+                        start.col > 0 && start.col < costMap.getWidth() - 1;
+  for (int i = 0; i < num_directions; ++i) {
     int row = start.row + dr[i];
     int col = start.col + dc[i];
 
-    if (row < 0 || row >= costMap.getHeight()) {
+    if (!interior) {
+      if (row < 0 || row >= costMap.getHeight()) {
+        continue;
+      }
+      if (col < 0 || col >= costMap.getWidth()) {
+        continue;
+      }
+    }
+
+    // Don't cut corners.
+    if (i >= 4 && (!isFeasible(costMap, row, start.col) ||
+                   !isFeasible(costMap, start.row, col))) {
       continue;
     }
-    if (col < 0 || col >= costMap.getWidth()) {
+
+    result.push_back(row, col);
+  }
+}
+
+using PathCostToCell = std::pair<double, Cell>;
+
+// Min-heap on cost.
+bool heapCompare(PathCostToCell const &p1, PathCostToCell const &p2) {
+  return p1.first > p2.first;
+}
+
+}  // namespace
+
+template <typename LayoutT>
+double computePath(Cell start, Cell end, Map2D<float, LayoutT> const &costMap,
+                   std::vector<Cell> &path, PlannerMode mode,
+                   PlannerStats *stats) {
+  BasicPlannerScratch<LayoutT> scratch(costMap.getWidth(),
+                                       costMap.getHeight());
+  return computePath(start, end, costMap, path, mode, scratch, stats);
+}
+
+template <typename LayoutT>
+double computePath(Cell start, Cell end, Map2D<float, LayoutT> const &costMap,
+                   std::vector<Cell> &path, PlannerMode mode,
+                   BasicPlannerScratch<LayoutT> &scratch, PlannerStats *stats) {
+  const auto begin = std::chrono::steady_clock::now();
+  scratch.reset();
+  impl::explore({start}, {end}, costMap, mode, scratch, stats);
+  const auto explored = std::chrono::steady_clock::now();
+
+  const double cost =
+      findPathFromExploration(start, end, scratch.explored, path);
+  if (stats) {
+    stats->search_ms +=
+        std::chrono::duration<double, std::milli>(explored - begin).count();
+    stats->path_ms += std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - explored)
+                          .count();
+  }
+  return cost;
+}
+
+double computeBidirectionalPath(Cell start, Cell end,
+                                Map2D<float> const &costMap,
+                                std::vector<Cell> &path, PlannerMode mode,
+                                PlannerStats *stats) {
+  if (mode == PlannerMode::ANY_ANGLE) {
+    return computePath(start, end, costMap, path, mode, stats);
+  }
+
+  PlannerStats local_stats;
+  if (stats == nullptr) {
+    stats = &local_stats;
+  }
+  const auto begin = std::chrono::steady_clock::now();
+
+  path.clear();
+  if (std::isinf(costMap.getCost(start)) || std::isinf(costMap.getCost(end))) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // forward: cost from start to each cell, including both cell costs.
+  // backward: cost from each cell to end, excluding the cell's own cost.
+  // Parents in backward point towards end.
+  DistanceField forward(costMap.getWidth(), costMap.getHeight());
+  DistanceField backward(costMap.getWidth(), costMap.getHeight());
+  std::vector<PathCostToCell> forward_queue, backward_queue;
+
+  forward.getCost(start).cost = costMap.getCost(start);
+  forward_queue.push_back(PathCostToCell(costMap.getCost(start), start));
+  backward.getCost(end).cost = 0.0;
+  backward_queue.push_back(PathCostToCell(0.0, end));
+  stats->heap_pushes += 2;
+  stats->heap_peak_size = std::max<size_t>(stats->heap_peak_size, 2);
+
+  // Cheapest path through a cell labeled by both searches so far.
+  double best_cost = std::numeric_limits<double>::infinity();
+  Cell meeting = start;
+  if (start == end) {
+    best_cost = costMap.getCost(start);
+  }
+
+  // Once the cheapest unexpanded cells on both sides sum to best_cost or more,
+  // no path through an unexpanded cell can be cheaper. An empty queue means
+  // that side is done, and every cell it reached was checked for a meeting.
+  while (!forward_queue.empty() && !backward_queue.empty() &&
+         forward_queue.front().first + backward_queue.front().first <
+             best_cost) {
+    // Grow the side with the smaller frontier.
+    const bool is_forward = forward_queue.size() <= backward_queue.size();
+    std::vector<PathCostToCell> &queue =
+        is_forward ? forward_queue : backward_queue;
+    DistanceField &field = is_forward ? forward : backward;
+    DistanceField const &other_field = is_forward ? backward : forward;
+
+    std::pop_heap(queue.begin(), queue.end(), heapCompare);
+    const double current_cost = queue.back().first;
+    const Cell current_cell = queue.back().second;
+    queue.pop_back();
+    ++stats->heap_pops;
+
+    if (current_cost > field.getCost(current_cell).cost) {
       continue;
     }
+    ++stats->expansions;
+
+    impl::NeighborList neighbors;
+    getNeighbors(costMap, current_cell, mode, neighbors);
+    for (int i = 0; i < neighbors.size(); ++i) {
+      const Cell n = neighbors[i];
+      if (std::isinf(costMap.getCost(n))) {
+        continue;
+      }
+
+      ++stats->relaxations;
+
+      // Moves cost the same both ways, but the entered cell is n going
+      // forward and current_cell going backward.
+      const double neighbor_cost =
+          current_cost +
+          costMap.getCost(is_forward ? n : current_cell) +
+          impl::travelCost(current_cell, n);
+      if (neighbor_cost >= field.getCost(n).cost) {
+        continue;
+      }
+
+      field.getCost(n).cost = neighbor_cost;
+      field.getCost(n).parent = current_cell;
+      queue.push_back(PathCostToCell(neighbor_cost, n));
+      std::push_heap(queue.begin(), queue.end(), heapCompare);
+      ++stats->heap_pushes;
+      stats->heap_peak_size =
+          std::max(stats->heap_peak_size,
+                   forward_queue.size() + backward_queue.size());
+
+      const double through_cost = neighbor_cost + other_field.getCost(n).cost;
+      if (through_cost < best_cost) {
+        best_cost = through_cost;
+        meeting = n;
+      }
+    }
+  }
+
+  const auto searched = std::chrono::steady_clock::now();
+  stats->search_ms +=
+      std::chrono::duration<double, std::milli>(searched - begin).count();
+  if (std::isinf(best_cost)) {
+    return best_cost;
+  }
 
-    result.push_back(Cell(row, col));
+  // start -> meeting from forward, then meeting -> end from backward.
+  for (std::optional<Cell> current = meeting; current;
+       current = forward.getCost(*current).parent) {
+    path.push_back(*current);
+  }
+  std::reverse(path.begin(), path.end());
+  for (std::optional<Cell> current = backward.getCost(meeting).parent; current;
+       current = backward.getCost(*current).parent) {
+    path.push_back(*current);
+  }
+  stats->path_ms += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - searched)
+                        .count();
+  return best_cost;
+}
+
+template <typename LayoutT>
+void BasicPlannerScratch<LayoutT>::reset() {
+  for (const Cell cell : touched) {
+    explored.getCost(cell) = impl::CellCostAndParent();
+  }
+  touched.clear();
+  heap.clear();
+}
+
+DistanceField computeDistanceField(Cell start, Map2D<float> const &costMap,
+                                   PlannerMode mode) {
+  return computeDistanceField(std::vector<Cell>{start}, costMap, mode);
+}
+
+DistanceField computeDistanceField(std::vector<Cell> const &starts,
+                                   Map2D<float> const &costMap,
+                                   PlannerMode mode) {
+  PlannerScratch scratch(costMap.getWidth(), costMap.getHeight());
+  impl::explore(starts, /*ends=*/{}, costMap, mode, scratch);
+  return std::move(scratch.explored);
+}
+
+double findPathInField(DistanceField const &field, Cell end,
+                       std::vector<Cell> &path) {
+  path.clear();
+  if (std::isinf(field.getCost(end).cost)) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  for (std::optional<Cell> current = end; current;
+       current = field.getCost(*current).parent) {
+    path.push_back(*current);
+  }
+  std::reverse(path.begin(), path.end());
+
+  return field.getCost(end).cost;
+}
+
+std::vector<double> computeCosts(Cell start, std::vector<Cell> const &ends,
+                                 Map2D<float> const &costMap,
+                                 PlannerMode mode) {
+  PlannerScratch scratch(costMap.getWidth(), costMap.getHeight());
+  impl::explore({start}, ends, costMap, mode, scratch);
+
+  std::vector<double> result;
+  result.reserve(ends.size());
+  for (const Cell end : ends) {
+    result.push_back(scratch.explored.getCost(end).cost);
   }
   return result;
 }
 
-struct PathCostToCell {
-  double cost;
-  Cell cell;
+std::vector<std::vector<double> > computeCostMatrix(
+    std::vector<Cell> const &starts, std::vector<Cell> const &ends,
+    Map2D<float> const &costMap, PlannerMode mode) {
+  std::vector<std::vector<double> > result(starts.size());
 
-  PathCostToCell(double _cost, Cell _cell) : cost(_cost), cell(_cell) {}
-};
+  const bool symmetric = mode != PlannerMode::ANY_ANGLE;
+  if (!symmetric || starts.size() <= ends.size()) {
+    for (size_t i = 0; i < starts.size(); ++i) {
+      result[i] = computeCosts(starts[i], ends, costMap, mode);
+    }
+    return result;
+  }
 
-// std::greater
-bool operator>(PathCostToCell const &p1, PathCostToCell const &p2) {
-  return p1.cost > p2.cost;
+  // Fewer ends: expand from each end and transpose.
+  for (auto &row : result) {
+    row.resize(ends.size());
+  }
+  for (size_t j = 0; j < ends.size(); ++j) {
+    const std::vector<double> costs =
+        computeCosts(ends[j], starts, costMap, mode);
+    for (size_t i = 0; i < starts.size(); ++i) {
+      result[i][j] = costs[i];
+    }
+  }
+  return result;
 }
 
-}  // namespace
+namespace impl {
 
-double computePath(Cell start, Cell end, Map2D<float> const &costMap,
-                   std::vector<Cell> &path) {
-  Map2D<impl::CellCostAndParent> explored_map =
-      Map2D<impl::CellCostAndParent>(costMap.getWidth(), costMap.getHeight());
+template <typename LayoutT>
+void explore(std::vector<Cell> const &starts, std::vector<Cell> const &ends,
+             Map2D<float, LayoutT> const &costMap, PlannerMode mode,
+             BasicPlannerScratch<LayoutT> &scratch, PlannerStats *stats) {
+  PlannerStats local_stats;
+  if (stats == nullptr) {
+    stats = &local_stats;
+  }
+  Map2D<CellCostAndParent, LayoutT> &explored_map = scratch.explored;
+  std::vector<Cell> &touched = scratch.touched;
 
   // Priority queue ordered by minimum cost ("first").
   // Note that the same value can be added to the queue with different costs.
-  std::priority_queue<PathCostToCell, std::deque<PathCostToCell>,
-                      std::greater<PathCostToCell> > queue;
+  std::vector<PathCostToCell> &queue = scratch.heap;
+
+  for (const Cell start : starts) {
+    double start_cost = costMap.getCost(start);
+    queue.push_back(PathCostToCell(start_cost, start));
+    std::push_heap(queue.begin(), queue.end(), heapCompare);
+    ++stats->heap_pushes;
+    stats->heap_peak_size = std::max(stats->heap_peak_size, queue.size());
+    explored_map.getCost(start).cost = start_cost;
+    touched.push_back(start);
+  }
 
-  double start_cost = costMap.getCost(start);
-  queue.push(PathCostToCell(start_cost, start));
-  explored_map.getCost(start).cost = start_cost;
+  // Number of times each end cell appears in ends, by cell index.
+  std::unordered_map<int, int> remaining_ends;
+  for (const Cell end : ends) {
+    ++remaining_ends[end.row * costMap.getWidth() + end.col];
+  }
+  // Theta* costs can still drop after expansion, so ANY_ANGLE can't stop
+  // early (see explore's doc).
+  size_t num_remaining_ends =
+      mode == PlannerMode::ANY_ANGLE ? 0 : ends.size();
 
   while (!queue.empty()) {
-    const PathCostToCell current = queue.top();
-    queue.pop();
+    std::pop_heap(queue.begin(), queue.end(), heapCompare);
+    const double current_cost = queue.back().first;
+    const Cell current_cell = queue.back().second;
+    queue.pop_back();
+    ++stats->heap_pops;
 
     // Check if we've already processed this cell with a lower cost.
-    if (current.cost > explored_map.getCost(current.cell).cost) {
+    if (current_cost > explored_map.getCost(current_cell).cost) {
       continue;
     }
+    ++stats->expansions;
+
+    if (num_remaining_ends > 0) {
+      auto end_iter = remaining_ends.find(
+          current_cell.row * costMap.getWidth() + current_cell.col);
+      if (end_iter != remaining_ends.end()) {
+        num_remaining_ends -= end_iter->second;
+        remaining_ends.erase(end_iter);
+        if (num_remaining_ends == 0) {
+          return;
+        }
+      }
+    }
 
-    const auto &neighbors = getNeighbors(costMap, current.cell);
-    for (const Cell n : neighbors) {
+    const std::optional<Cell> grandparent =
+        explored_map.getCost(current_cell).parent;
+
+    impl::NeighborList neighbors;
+    getNeighbors(costMap, current_cell, mode, neighbors);
+    for (int i = 0; i < neighbors.size(); ++i) {
+      const Cell n = neighbors[i];
       if (std::isinf(costMap.getCost(n))) {
         continue;
       }
 
-      // Cost to move one cell (diagonal moves not supported).
-      static const double TRAVEL_COST = 1.0;
-      double neighbor_cost = current.cost + costMap.getCost(n) + TRAVEL_COST;
+      ++stats->relaxations;
+      Cell parent = current_cell;
+      double neighbor_cost =
+          current_cost + costMap.getCost(n) + travelCost(current_cell, n);
+
+      // Theta*: skip the current cell if the grandparent can see n directly.
+      if (mode == PlannerMode::ANY_ANGLE && grandparent) {
+        double shortcut_cost = explored_map.getCost(*grandparent).cost +
+                               lineCost(costMap, *grandparent, n);
+        if (shortcut_cost < neighbor_cost) {
+          parent = *grandparent;
+          neighbor_cost = shortcut_cost;
+        }
+      }
 
       // See if we're already reached this cell from another direction.
-      // Ex: parent, or lower-cost path.
-      if (neighbor_cost > explored_map.getCost(n).cost) {
+      // Ex: parent, or lower-cost path. Ties are skipped too, otherwise
+      // Theta* shortcuts through the same grandparent re-queue forever.
+      if (neighbor_cost >= explored_map.getCost(n).cost) {
         continue;
       }
 
-      queue.push(PathCostToCell(neighbor_cost, n));
+      queue.push_back(PathCostToCell(neighbor_cost, n));
+      std::push_heap(queue.begin(), queue.end(), heapCompare);
+      ++stats->heap_pushes;
+      stats->heap_peak_size = std::max(stats->heap_peak_size, queue.size());
+      if (std::isinf(explored_map.getCost(n).cost)) {
+        touched.push_back(n);
+      }
       explored_map.getCost(n).cost = neighbor_cost;
-      explored_map.getCost(n).parent = current.cell;
+      explored_map.getCost(n).parent = parent;
     }
   }
+}
 
-  return findPathFromExploration(start, end, explored_map, path);
+double travelCost(Cell from, Cell to) {
+  return std::hypot(to.row - from.row, to.col - from.col);
 }
 
-namespace impl {
+template <typename LayoutT>
+double lineCost(Map2D<float, LayoutT> const &costMap, Cell from, Cell to) {
+  const int num_rows = std::abs(to.row - from.row);
+  const int num_cols = std::abs(to.col - from.col);
+  const int step_row = to.row > from.row ? 1 : -1;
+  const int step_col = to.col > from.col ? 1 : -1;
 
-double findPathFromExploration(Cell start, Cell end,
-                               Map2D<CellCostAndParent> const &explored_map,
-                               std::vector<Cell> &path) {
+  double cost = travelCost(from, to);
+  Cell current = from;
+
+  // Step along the segment between cell centers, one cell boundary at a time.
+  // i_row/i_col count the row/col boundaries crossed so far.
+  for (int i_row = 0, i_col = 0; i_row < num_rows || i_col < num_cols;) {
+    // Compare where the segment crosses the next row boundary vs the next col
+    // boundary, (0.5 + i_col) / num_cols vs (0.5 + i_row) / num_rows.
+    const long decision = static_cast<long>(1 + 2 * i_col) * num_rows -
+                          static_cast<long>(1 + 2 * i_row) * num_cols;
+    if (decision == 0) {
+      // Passing through a corner. Both side cells must be open.
+      if (!isFeasible(costMap, current.row + step_row, current.col) ||
+          !isFeasible(costMap, current.row, current.col + step_col)) {
+        return std::numeric_limits<double>::infinity();
+      }
+      current.row += step_row;
+      current.col += step_col;
+      ++i_row;
+      ++i_col;
+    } else if (decision < 0) {
+      current.col += step_col;
+      ++i_col;
+    } else {
+      current.row += step_row;
+      ++i_row;
+    }
+
+    cost += costMap.getCost(current);
+    if (std::isinf(cost)) {
+      return cost;
+    }
+  }
+
+  return cost;
+}
+
+template <typename LayoutT>
+double findPathFromExploration(
+    Cell start, Cell end, Map2D<CellCostAndParent, LayoutT> const &explored_map,
+    std::vector<Cell> &path) {
   // Work backwards from end, using the parent cell in explored_map.
   Cell current = end;
 
@@ -119,3 +480,35 @@ double findPathFromExploration(Cell start, Cell end,
 }
 
 }  // namespace impl
+
+// Layouts the planner is built for. To add one, instantiate it here too.
+
+template struct BasicPlannerScratch<RowMajorLayout>;
+template double computePath(Cell, Cell, Map2D<float> const &,
+                            std::vector<Cell> &, PlannerMode, PlannerStats *);
+template double computePath(Cell, Cell, Map2D<float> const &,
+                            std::vector<Cell> &, PlannerMode,
+                            PlannerScratch &, PlannerStats *);
+template void impl::explore(std::vector<Cell> const &,
+                            std::vector<Cell> const &, Map2D<float> const &,
+                            PlannerMode, PlannerScratch &, PlannerStats *);
+template double impl::lineCost(Map2D<float> const &, Cell, Cell);
+template double impl::findPathFromExploration(
+    Cell, Cell, DistanceField const &, std::vector<Cell> &);
+
+using TiledCostMap = Map2D<float, TiledLayout<> >;
+using TiledScratch = BasicPlannerScratch<TiledLayout<> >;
+
+template struct BasicPlannerScratch<TiledLayout<> >;
+template double computePath(Cell, Cell, TiledCostMap const &,
+                            std::vector<Cell> &, PlannerMode, PlannerStats *);
+template double computePath(Cell, Cell, TiledCostMap const &,
+                            std::vector<Cell> &, PlannerMode, TiledScratch &,
+                            PlannerStats *);
+template void impl::explore(std::vector<Cell> const &,
+                            std::vector<Cell> const &, TiledCostMap const &,
+                            PlannerMode, TiledScratch &, PlannerStats *);
+template double impl::lineCost(TiledCostMap const &, Cell, Cell);
+template double impl::findPathFromExploration(
+    Cell, Cell, Map2D<impl::CellCostAndParent, TiledLayout<> > const &,
+    std::vector<Cell> &);
@@ -0,0 +1,205 @@
+#include "dstar_lite_planner.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "map_2d.hh"
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+DStarLitePlanner::DStarLitePlanner(Map2D<float> const &costMap, Cell start,
+                                   Cell end)
+    : costMap_(costMap),
+      start_(start),
+      end_(end),
+      lastStart_(start),
+      states_(costMap.getWidth(), costMap.getHeight()) {
+  // Search backwards from the goal.
+  CellState &goal = states_.getCost(end_);
+  goal.rhs = 0.0;
+  goal.queued = true;
+  goal.key1 = heuristic(end_);
+  goal.key2 = 0.0;
+  queue_.insert(QueueEntry(goal.key1, goal.key2, cellIndex(end_)));
+}
+
+double DStarLitePlanner::heuristic(Cell cell) const {
+  // Every move costs at least 1.0.
+  return std::abs(cell.row - start_.row) + std::abs(cell.col - start_.col);
+}
+
+double DStarLitePlanner::edgeCost(Cell cell) const {
+  return costMap_.getCost(cell) + 1.0;
+}
+
+void DStarLitePlanner::getNeighbors(Cell cell,
+                                    impl::NeighborList &neighbors) const {
+  static const int dr[] = {-1, 1, 0, 0};
+  static const int dc[] = {0, 0, -1, 1};
+  for (int i = 0; i < 4; ++i) {
+    int row = cell.row + dr[i];
+    int col = cell.col + dc[i];
+    if (row < 0 || row >= costMap_.getHeight()) {
+      continue;
+    }
+    if (col < 0 || col >= costMap_.getWidth()) {
+      continue;
+    }
+    neighbors.push_back(row, col);
+  }
+}
+
+void DStarLitePlanner::updateVertex(Cell cell, PlannerStats *stats) {
+  CellState &state = states_.getCost(cell);
+
+  if (cell != end_) {
+    impl::NeighborList neighbors;
+    getNeighbors(cell, neighbors);
+
+    state.rhs = INF;
+    for (int i = 0; i < neighbors.size(); ++i) {
+      const Cell n = neighbors[i];
+      state.rhs = std::min(state.rhs, edgeCost(n) + states_.getCost(n).g);
+    }
+  }
+
+  if (state.queued) {
+    queue_.erase(QueueEntry(state.key1, state.key2, cellIndex(cell)));
+    state.queued = false;
+  }
+
+  if (state.g != state.rhs) {
+    const double min_g = std::min(state.g, state.rhs);
+    state.queued = true;
+    state.key1 = min_g + heuristic(cell) + km_;
+    state.key2 = min_g;
+    queue_.insert(QueueEntry(state.key1, state.key2, cellIndex(cell)));
+    if (stats) {
+      ++stats->heap_pushes;
+    }
+  }
+}
+
+void DStarLitePlanner::computeShortestPath(PlannerStats *stats) {
+  while (!queue_.empty()) {
+    // Done once start is consistent and no queued cell can improve it.
+    const CellState &start = states_.getCost(start_);
+    const double start_min_g = std::min(start.g, start.rhs);
+    const QueueEntry top = *queue_.begin();
+    if (std::make_pair(std::get<0>(top), std::get<1>(top)) >=
+            std::make_pair(start_min_g + km_, start_min_g) &&
+        start.rhs == start.g) {
+      break;
+    }
+
+    const Cell cell = indexCell(std::get<2>(top));
+    CellState &state = states_.getCost(cell);
+    if (stats) {
+      ++stats->heap_pops;
+    }
+
+    // Key is out of date (start moved): requeue.
+    const double min_g = std::min(state.g, state.rhs);
+    const double new_key1 = min_g + heuristic(cell) + km_;
+    if (state.key1 < new_key1) {
+      queue_.erase(queue_.begin());
+      state.key1 = new_key1;
+      state.key2 = min_g;
+      queue_.insert(QueueEntry(state.key1, state.key2, cellIndex(cell)));
+      if (stats) {
+        ++stats->heap_pushes;
+      }
+      continue;
+    }
+
+    if (stats) {
+      ++stats->expansions;
+    }
+
+    queue_.erase(queue_.begin());
+    state.queued = false;
+
+    impl::NeighborList neighbors;
+    getNeighbors(cell, neighbors);
+    if (state.g > state.rhs) {
+      // Overconsistent: cost-to-goal improved.
+      state.g = state.rhs;
+    } else {
+      // Underconsistent: cost-to-goal got worse.
+      state.g = INF;
+      updateVertex(cell, stats);
+    }
+    for (int i = 0; i < neighbors.size(); ++i) {
+      updateVertex(neighbors[i], stats);
+    }
+  }
+}
+
+double DStarLitePlanner::computePath(std::vector<Cell> &path,
+                                     PlannerStats *stats) {
+  computeShortestPath(stats);
+
+  path.clear();
+  if (std::isinf(costMap_.getCost(start_)) ||
+      std::isinf(states_.getCost(start_).g)) {
+    return INF;
+  }
+
+  // Follow the cheapest successor down to the goal. Every step must lower g,
+  // so the walk can't cycle on ties or a stale g.
+  Cell current = start_;
+  path.push_back(current);
+  while (current != end_) {
+    impl::NeighborList neighbors;
+    getNeighbors(current, neighbors);
+
+    double best_cost = INF;
+    Cell best = current;
+    for (int i = 0; i < neighbors.size(); ++i) {
+      const Cell n = neighbors[i];
+      double cost = edgeCost(n) + states_.getCost(n).g;
+      if (cost < best_cost) {
+        best_cost = cost;
+        best = n;
+      }
+    }
+    if (best == current ||
+        !(states_.getCost(best).g < states_.getCost(current).g)) {
+      path.clear();
+      return INF;
+    }
+
+    current = best;
+    path.push_back(current);
+  }
+
+  return costMap_.getCost(start_) + states_.getCost(start_).g;
+}
+
+void DStarLitePlanner::updateCell(Cell cell, float cost) {
+  if (costMap_.getCost(cell) == cost) {
+    return;
+  }
+  costMap_.getCost(cell) = cost;
+
+  // Only edges into cell changed.
+  impl::NeighborList neighbors;
+  getNeighbors(cell, neighbors);
+  for (int i = 0; i < neighbors.size(); ++i) {
+    updateVertex(neighbors[i], /*stats=*/nullptr);
+  }
+}
+
+void DStarLitePlanner::setStart(Cell start) {
+  // Keys already queued used the old start; km_ keeps them lower bounds.
+  start_ = start;
+  km_ += std::abs(lastStart_.row - start_.row) +
+         std::abs(lastStart_.col - start_.col);
+  lastStart_ = start_;
+}
@@ -0,0 +1,121 @@
+#include "dynamic_cost_map.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <optional>
+
+// Map2D copies are deep, even of external storage (ex: loadMapFile), so a
+// snapshot never aliases the caller's map or another snapshot.
+DynamicCostMap::Snapshot::Snapshot(Map2D<float> const &_map, int _tileSize)
+    : map(_map),
+      tile_size(_tileSize),
+      tiles_per_row((_map.getWidth() + _tileSize - 1) / _tileSize),
+      tile_versions(tiles_per_row *
+                    ((_map.getHeight() + _tileSize - 1) / _tileSize)) {
+  assert(tile_size > 0);
+}
+
+std::vector<int> DynamicCostMap::Snapshot::getChangedTiles(
+    uint64_t sinceVersion) const {
+  std::vector<int> result;
+  for (size_t tile = 0; tile < tile_versions.size(); ++tile) {
+    if (tile_versions[tile] > sinceVersion) {
+      result.push_back(tile);
+    }
+  }
+  return result;
+}
+
+std::pair<Cell, Cell> DynamicCostMap::Snapshot::getTileBounds(int tile) const {
+  const int row = (tile / tiles_per_row) * tile_size;
+  const int col = (tile % tiles_per_row) * tile_size;
+  return {Cell(row, col), Cell(std::min(map.getHeight(), row + tile_size),
+                               std::min(map.getWidth(), col + tile_size))};
+}
+
+DynamicCostMap::DynamicCostMap(Map2D<float> const &initial, int tileSize)
+    : current_{std::make_shared<Snapshot>(initial, tileSize),
+               std::make_shared<std::atomic<bool> >(false)},
+      published_(lease(current_)) {}
+
+std::shared_ptr<const DynamicCostMap::Snapshot> DynamicCostMap::getSnapshot()
+    const {
+  return std::atomic_load(&published_);
+}
+
+std::shared_ptr<const DynamicCostMap::Snapshot> DynamicCostMap::lease(
+    Buffer const &buffer) {
+  buffer.in_use->store(true, std::memory_order_relaxed);
+
+  // The deleter runs when the last reader (or published_) lets go. It keeps
+  // the snapshot alive, so readers may outlive this map.
+  std::shared_ptr<Snapshot> snapshot = buffer.snapshot;
+  std::shared_ptr<std::atomic<bool> > in_use = buffer.in_use;
+  return std::shared_ptr<const Snapshot>(
+      snapshot.get(), [snapshot, in_use](Snapshot const *) {
+        in_use->store(false, std::memory_order_release);
+      });
+}
+
+std::optional<DynamicCostMap::Buffer> DynamicCostMap::takeFreeSpare() {
+  // Retired snapshots are never published again, so once a lease is gone,
+  // nobody can see the buffer. The acquire load pairs with the lease's
+  // release, so readers' last reads happen before it's rewritten. Prefer the
+  // newest, which has the fewest tiles to catch up.
+  auto best = spares_.end();
+  for (auto iter = spares_.begin(); iter != spares_.end(); ++iter) {
+    if (!iter->in_use->load(std::memory_order_acquire) &&
+        (best == spares_.end() ||
+         iter->snapshot->version > best->snapshot->version)) {
+      best = iter;
+    }
+  }
+  if (best == spares_.end()) {
+    return std::nullopt;
+  }
+
+  Buffer spare = std::move(*best);
+  *best = std::move(spares_.back());
+  spares_.pop_back();
+  return spare;
+}
+
+uint64_t DynamicCostMap::update(
+    std::vector<std::pair<Cell, float> > const &changes) {
+  std::optional<Buffer> spare = takeFreeSpare();
+  Buffer next;
+  if (spare) {
+    next = std::move(*spare);
+
+    // Catch up with the updates since it was published.
+    Snapshot &map = *next.snapshot;
+    for (const int tile : current_.snapshot->getChangedTiles(map.version)) {
+      const auto bounds = current_.snapshot->getTileBounds(tile);
+      for (int row = bounds.first.row; row < bounds.second.row; ++row) {
+        for (int col = bounds.first.col; col < bounds.second.col; ++col) {
+          map.map.getCost(Cell(row, col)) =
+              current_.snapshot->map.getCost(Cell(row, col));
+        }
+      }
+    }
+    map.version = current_.snapshot->version;
+    map.tile_versions = current_.snapshot->tile_versions;
+  } else {
+    // Every buffer is held by a reader: add one to the pool.
+    next = {std::make_shared<Snapshot>(*current_.snapshot),
+            std::make_shared<std::atomic<bool> >(false)};
+  }
+
+  Snapshot &snapshot = *next.snapshot;
+  ++snapshot.version;
+  for (const auto &change : changes) {
+    snapshot.map.getCost(change.first) = change.second;
+    snapshot.tile_versions[snapshot.getTile(change.first)] = snapshot.version;
+  }
+
+  std::atomic_store(&published_, lease(next));
+  spares_.push_back(std::move(current_));
+  current_ = std::move(next);
+  return snapshot.version;
+}
@@ -0,0 +1,51 @@
+#include "exploration_heatmap.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+bool saveExplorationHeatmap(std::string const &path,
+                            DistanceField const &explored,
+                            Map2D<float> const &costMap) {
+  const int width = explored.getWidth();
+  const int height = explored.getHeight();
+
+  double max_cost = 0.0;
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const double cost = explored.getCost(Cell(row, col)).cost;
+      if (!std::isinf(cost)) {
+        max_cost = std::max(max_cost, cost);
+      }
+    }
+  }
+
+  // RGB, row major.
+  std::vector<unsigned char> pixels;
+  pixels.reserve(3 * width * height);
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const Cell cell(row, col);
+      const double cost = explored.getCost(cell).cost;
+      if (std::isinf(costMap.getCost(cell))) {
+        pixels.insert(pixels.end(), {0, 0, 0});
+      } else if (std::isinf(cost)) {
+        pixels.insert(pixels.end(), {255, 255, 255});
+      } else {
+        const double t = max_cost > 0.0 ? cost / max_cost : 0.0;
+        const unsigned char red = (unsigned char)std::lround(255.0 * t);
+        pixels.insert(pixels.end(), {red, 0, (unsigned char)(255 - red)});
+      }
+    }
+  }
+
+  FILE *file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = std::fprintf(file, "P6\n%d %d\n255\n", width, height) > 0;
+  ok = ok && std::fwrite(pixels.data(), 1, pixels.size(), file) ==
+                 pixels.size();
+  return std::fclose(file) == 0 && ok;
+}
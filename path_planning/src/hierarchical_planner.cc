@@ -0,0 +1,506 @@
+#include "hierarchical_planner.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <utility>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+namespace {
+
+// With entranceSpacing > 1, runs shorter than this get a single entrance in
+// the middle.
+static const int MIN_RUN_FOR_TWO_ENTRANCES = 6;
+
+using PathCostToCell = std::pair<double, Cell>;
+
+// Min-heap on cost.
+bool heapCompare(PathCostToCell const &p1, PathCostToCell const &p2) {
+  return p1.first > p2.first;
+}
+
+bool isOpen(Map2D<float> const &costMap, Cell cell) {
+  return !std::isinf(costMap.getCost(cell));
+}
+
+/**
+ * Dijkstra (4-connected) from source, restricted to the width x height cells
+ * at origin. explored's (0, 0) is at origin and it must be at least that
+ * large; it is reset first. Costs include source's cost; parents are in map
+ * coordinates.
+ */
+void searchInBounds(Map2D<float> const &costMap, Cell origin, int width,
+                    int height, Cell source,
+                    Map2D<impl::CellCostAndParent> &explored,
+                    std::vector<PathCostToCell> &queue) {
+  auto local = [&](Cell cell) {
+    return Cell(cell.row - origin.row, cell.col - origin.col);
+  };
+
+  explored.fill(impl::CellCostAndParent());
+  queue.clear();
+
+  double source_cost = costMap.getCost(source);
+  explored.getCost(local(source)).cost = source_cost;
+  queue.emplace_back(source_cost, source);
+
+  static const int dr[] = {-1, 1, 0, 0};
+  static const int dc[] = {0, 0, -1, 1};
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), heapCompare);
+    const PathCostToCell current = queue.back();
+    queue.pop_back();
+
+    if (current.first > explored.getCost(local(current.second)).cost) {
+      continue;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+      const Cell n(current.second.row + dr[i], current.second.col + dc[i]);
+      const Cell n_local = local(n);
+      if (n_local.row < 0 || n_local.row >= height || n_local.col < 0 ||
+          n_local.col >= width) {
+        continue;
+      }
+      if (!isOpen(costMap, n)) {
+        continue;
+      }
+
+      double neighbor_cost = current.first + costMap.getCost(n) + 1.0;
+      impl::CellCostAndParent &n_explored = explored.getCost(n_local);
+      if (neighbor_cost >= n_explored.cost) {
+        continue;
+      }
+
+      n_explored.cost = neighbor_cost;
+      n_explored.parent = current.second;
+      queue.emplace_back(neighbor_cost, n);
+      std::push_heap(queue.begin(), queue.end(), heapCompare);
+    }
+  }
+}
+
+}  // namespace
+
+HierarchicalPlanner::HierarchicalPlanner(Map2D<float> const &costMap,
+                                         int clusterSize, int entranceSpacing)
+    : costMap_(costMap),
+      clusterSize_(clusterSize),
+      entranceSpacing_(entranceSpacing > 0 ? entranceSpacing : clusterSize),
+      clusterRows_((costMap.getHeight() + clusterSize - 1) / clusterSize),
+      clusterCols_((costMap.getWidth() + clusterSize - 1) / clusterSize),
+      clusters_(clusterRows_ * clusterCols_),
+      rightBorders_(clusterRows_ * clusterCols_),
+      bottomBorders_(clusterRows_ * clusterCols_),
+      entranceIndex_(costMap.getWidth(), costMap.getHeight()) {
+  assert(clusterSize_ > 0);
+  entranceIndex_.fill(-1);
+
+  for (int cr = 0; cr < clusterRows_; ++cr) {
+    for (int cc = 0; cc < clusterCols_; ++cc) {
+      Cluster &cluster = clusters_[cr * clusterCols_ + cc];
+      cluster.row_begin = cr * clusterSize_;
+      cluster.col_begin = cc * clusterSize_;
+      cluster.row_end =
+          std::min(costMap_.getHeight(), (cr + 1) * clusterSize_);
+      cluster.col_end = std::min(costMap_.getWidth(), (cc + 1) * clusterSize_);
+    }
+  }
+
+  for (int cr = 0; cr < clusterRows_; ++cr) {
+    for (int cc = 0; cc < clusterCols_; ++cc) {
+      buildBorder(cr, cc, /*right=*/true);
+      buildBorder(cr, cc, /*right=*/false);
+    }
+  }
+
+  for (int cr = 0; cr < clusterRows_; ++cr) {
+    for (int cc = 0; cc < clusterCols_; ++cc) {
+      buildCluster(cr, cc);
+    }
+  }
+  indexEntrances();
+}
+
+HierarchicalPlanner::Scratch::Scratch(HierarchicalPlanner const &planner)
+    : start_explored(planner.clusterSize_, planner.clusterSize_),
+      end_explored(planner.clusterSize_, planner.clusterSize_),
+      refine_explored(planner.clusterSize_, planner.clusterSize_) {}
+
+int HierarchicalPlanner::clusterIndex(Cell cell) const {
+  return (cell.row / clusterSize_) * clusterCols_ + cell.col / clusterSize_;
+}
+
+int HierarchicalPlanner::nodeId(Cell cell, Cell start) const {
+  const int i = entranceIndex_.getCost(cell);
+  if (i >= 0) {
+    return entranceOffsets_[clusterIndex(cell)] + i;
+  }
+  return cell == start ? getNumEntrances() : getNumEntrances() + 1;
+}
+
+void HierarchicalPlanner::indexEntrances() {
+  entranceOffsets_.assign(1, 0);
+  for (const auto &cluster : clusters_) {
+    entranceOffsets_.push_back(entranceOffsets_.back() +
+                               (int)cluster.entrances.size());
+  }
+}
+
+HierarchicalPlanner::Border &HierarchicalPlanner::rightBorder(int cluster_row,
+                                                              int cluster_col) {
+  return rightBorders_[cluster_row * clusterCols_ + cluster_col];
+}
+
+HierarchicalPlanner::Border &HierarchicalPlanner::bottomBorder(
+    int cluster_row, int cluster_col) {
+  return bottomBorders_[cluster_row * clusterCols_ + cluster_col];
+}
+
+HierarchicalPlanner::Border const &HierarchicalPlanner::rightBorder(
+    int cluster_row, int cluster_col) const {
+  return rightBorders_[cluster_row * clusterCols_ + cluster_col];
+}
+
+HierarchicalPlanner::Border const &HierarchicalPlanner::bottomBorder(
+    int cluster_row, int cluster_col) const {
+  return bottomBorders_[cluster_row * clusterCols_ + cluster_col];
+}
+
+void HierarchicalPlanner::buildBorder(int cluster_row, int cluster_col,
+                                      bool right) {
+  Border &border = right ? rightBorder(cluster_row, cluster_col)
+                         : bottomBorder(cluster_row, cluster_col);
+  border.clear();
+
+  if ((right && cluster_col + 1 >= clusterCols_) ||
+      (!right && cluster_row + 1 >= clusterRows_)) {
+    return;
+  }
+
+  Cluster const &cluster = clusters_[cluster_row * clusterCols_ + cluster_col];
+
+  // Walk along the border. i is the row (right) or col (bottom).
+  const int begin = right ? cluster.row_begin : cluster.col_begin;
+  const int end = right ? cluster.row_end : cluster.col_end;
+  auto pair_at = [&](int i) {
+    return right ? std::make_pair(Cell(i, cluster.col_end - 1),
+                                  Cell(i, cluster.col_end))
+                 : std::make_pair(Cell(cluster.row_end - 1, i),
+                                  Cell(cluster.row_end, i));
+  };
+  auto is_open_pair = [&](int i) {
+    const auto cells = pair_at(i);
+    return isOpen(costMap_, cells.first) && isOpen(costMap_, cells.second);
+  };
+
+  int i = begin;
+  while (i < end) {
+    if (!is_open_pair(i)) {
+      ++i;
+      continue;
+    }
+
+    const int run_begin = i;
+    while (i < end && is_open_pair(i)) {
+      ++i;
+    }
+    const int run_length = i - run_begin;
+
+    if (entranceSpacing_ > 1 && run_length < MIN_RUN_FOR_TWO_ENTRANCES) {
+      border.push_back(pair_at(run_begin + run_length / 2));
+      continue;
+    }
+    for (int j = run_begin; j < i - 1; j += entranceSpacing_) {
+      border.push_back(pair_at(j));
+    }
+    border.push_back(pair_at(i - 1));
+  }
+}
+
+void HierarchicalPlanner::buildCluster(int cluster_row, int cluster_col) {
+  Cluster &cluster = clusters_[cluster_row * clusterCols_ + cluster_col];
+
+  // Collect entrances and their crossings from all four borders.
+  std::vector<Cell> &entrances = cluster.entrances;
+  for (const Cell entrance : entrances) {
+    entranceIndex_.getCost(entrance) = -1;
+  }
+  entrances.clear();
+  cluster.crossings.clear();
+  auto add_crossing = [&](Cell from, Cell to) {
+    int &i = entranceIndex_.getCost(from);
+    if (i < 0) {
+      i = (int)entrances.size();
+      entrances.push_back(from);
+      cluster.crossings.emplace_back();
+    }
+    cluster.crossings[i].push_back(to);
+  };
+  for (const auto &cells : rightBorder(cluster_row, cluster_col)) {
+    add_crossing(cells.first, cells.second);
+  }
+  for (const auto &cells : bottomBorder(cluster_row, cluster_col)) {
+    add_crossing(cells.first, cells.second);
+  }
+  if (cluster_col > 0) {
+    for (const auto &cells : rightBorder(cluster_row, cluster_col - 1)) {
+      add_crossing(cells.second, cells.first);
+    }
+  }
+  if (cluster_row > 0) {
+    for (const auto &cells : bottomBorder(cluster_row - 1, cluster_col)) {
+      add_crossing(cells.second, cells.first);
+    }
+  }
+
+  // Precompute costs between entrances.
+  const size_t num_entrances = entrances.size();
+  cluster.costs.assign(num_entrances * num_entrances,
+                       std::numeric_limits<double>::infinity());
+
+  const Cell origin(cluster.row_begin, cluster.col_begin);
+  const int width = cluster.col_end - cluster.col_begin;
+  const int height = cluster.row_end - cluster.row_begin;
+  Map2D<impl::CellCostAndParent> explored(width, height);
+  std::vector<PathCostToCell> queue;
+  for (size_t i = 0; i < num_entrances; ++i) {
+    searchInBounds(costMap_, origin, width, height, entrances[i], explored,
+                   queue);
+
+    const double source_cost = costMap_.getCost(entrances[i]);
+    for (size_t j = 0; j < num_entrances; ++j) {
+      const Cell target(entrances[j].row - origin.row,
+                        entrances[j].col - origin.col);
+      cluster.costs[i * num_entrances + j] =
+          explored.getCost(target).cost - source_cost;
+    }
+  }
+}
+
+int HierarchicalPlanner::updateCells(std::vector<Cell> const &cells) {
+  // Borders are identified by the top/left cluster index.
+  std::set<int> dirty_right_borders, dirty_bottom_borders, dirty_clusters;
+
+  for (const Cell cell : cells) {
+    const int index = clusterIndex(cell);
+    const int cr = index / clusterCols_;
+    const int cc = index % clusterCols_;
+    Cluster const &cluster = clusters_[index];
+    dirty_clusters.insert(index);
+
+    if (cell.col == cluster.col_begin && cc > 0) {
+      dirty_right_borders.insert(index - 1);
+      dirty_clusters.insert(index - 1);
+    }
+    if (cell.col == cluster.col_end - 1 && cc + 1 < clusterCols_) {
+      dirty_right_borders.insert(index);
+      dirty_clusters.insert(index + 1);
+    }
+    if (cell.row == cluster.row_begin && cr > 0) {
+      dirty_bottom_borders.insert(index - clusterCols_);
+      dirty_clusters.insert(index - clusterCols_);
+    }
+    if (cell.row == cluster.row_end - 1 && cr + 1 < clusterRows_) {
+      dirty_bottom_borders.insert(index);
+      dirty_clusters.insert(index + clusterCols_);
+    }
+  }
+
+  for (int index : dirty_right_borders) {
+    buildBorder(index / clusterCols_, index % clusterCols_, /*right=*/true);
+  }
+  for (int index : dirty_bottom_borders) {
+    buildBorder(index / clusterCols_, index % clusterCols_, /*right=*/false);
+  }
+  for (int index : dirty_clusters) {
+    buildCluster(index / clusterCols_, index % clusterCols_);
+  }
+  indexEntrances();
+
+  return (int)dirty_clusters.size();
+}
+
+void HierarchicalPlanner::refineInCluster(Cluster const &cluster, Cell start,
+                                          Cell end, std::vector<Cell> &path,
+                                          Scratch &scratch) const {
+  const Cell origin(cluster.row_begin, cluster.col_begin);
+  Map2D<impl::CellCostAndParent> &explored = scratch.refine_explored;
+  searchInBounds(costMap_, origin, cluster.col_end - cluster.col_begin,
+                 cluster.row_end - cluster.row_begin, start, explored,
+                 scratch.cluster_heap);
+
+  // Walk back from end, then flip the appended segment.
+  const size_t segment_begin = path.size();
+  for (Cell current = end; current != start;) {
+    path.push_back(current);
+    current = *explored
+                   .getCost(Cell(current.row - origin.row,
+                                 current.col - origin.col))
+                   .parent;
+  }
+  std::reverse(path.begin() + segment_begin, path.end());
+}
+
+double HierarchicalPlanner::computePath(Cell start, Cell end,
+                                        std::vector<Cell> &path) const {
+  Scratch scratch(*this);
+  return computePath(start, end, path, scratch);
+}
+
+double HierarchicalPlanner::computePath(Cell start, Cell end,
+                                        std::vector<Cell> &path,
+                                        Scratch &scratch) const {
+  path.clear();
+  const double INF = std::numeric_limits<double>::infinity();
+  if (!isOpen(costMap_, start) || !isOpen(costMap_, end)) {
+    return INF;
+  }
+
+  const int start_index = clusterIndex(start);
+  const int end_index = clusterIndex(end);
+  Cluster const &start_cluster = clusters_[start_index];
+  Cluster const &end_cluster = clusters_[end_index];
+
+  // Connect start and end to the entrances of their clusters.
+  searchInBounds(costMap_,
+                 Cell(start_cluster.row_begin, start_cluster.col_begin),
+                 start_cluster.col_end - start_cluster.col_begin,
+                 start_cluster.row_end - start_cluster.row_begin, start,
+                 scratch.start_explored, scratch.cluster_heap);
+  searchInBounds(costMap_, Cell(end_cluster.row_begin, end_cluster.col_begin),
+                 end_cluster.col_end - end_cluster.col_begin,
+                 end_cluster.row_end - end_cluster.row_begin, end,
+                 scratch.end_explored, scratch.cluster_heap);
+
+  auto explored_cost = [](Cluster const &cluster,
+                          Map2D<impl::CellCostAndParent> const &explored,
+                          Cell cell) {
+    return explored
+        .getCost(Cell(cell.row - cluster.row_begin,
+                      cell.col - cluster.col_begin))
+        .cost;
+  };
+
+  // Dijkstra over the abstract graph: start, end and entrance cells. Start
+  // and end share the node of an entrance they're on, and each other's node
+  // if start == end.
+  std::vector<Scratch::Node> &nodes = scratch.nodes;
+  for (const int id : scratch.touched) {
+    nodes[id] = Scratch::Node();
+  }
+  scratch.touched.clear();
+  if (nodes.size() < (size_t)getNumEntrances() + 2) {
+    nodes.resize(getNumEntrances() + 2);
+  }
+  std::vector<PathCostToCell> &queue = scratch.heap;
+  queue.clear();
+
+  auto node_at = [&](Cell cell) -> Scratch::Node & {
+    const int id = nodeId(cell, start);
+    if (std::isinf(nodes[id].cost)) {
+      scratch.touched.push_back(id);
+    }
+    return nodes[id];
+  };
+  auto relax = [&](Cell from, Cell to, double cost) {
+    if (std::isinf(cost)) {
+      return;
+    }
+    Scratch::Node &node = node_at(to);
+    if (cost >= node.cost) {
+      return;
+    }
+    node.cost = cost;
+    node.parent = from;
+    queue.emplace_back(cost, to);
+    std::push_heap(queue.begin(), queue.end(), heapCompare);
+  };
+
+  node_at(start).cost = costMap_.getCost(start);
+  queue.emplace_back(costMap_.getCost(start), start);
+
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), heapCompare);
+    const PathCostToCell current = queue.back();
+    queue.pop_back();
+    const Cell cell = current.second;
+
+    if (current.first > nodes[nodeId(cell, start)].cost) {
+      continue;
+    }
+    if (cell == end) {
+      break;
+    }
+
+    if (cell == start) {
+      for (const Cell entrance : start_cluster.entrances) {
+        relax(start, entrance,
+              explored_cost(start_cluster, scratch.start_explored, entrance));
+      }
+      if (start_index == end_index) {
+        relax(start, end,
+              explored_cost(start_cluster, scratch.start_explored, end));
+      }
+    }
+
+    // Entrance edges: inside the cluster, across borders, and to end.
+    const int i = entranceIndex_.getCost(cell);
+    if (i < 0) {
+      continue;
+    }
+    const int index = clusterIndex(cell);
+    Cluster const &cluster = clusters_[index];
+    const size_t num_entrances = cluster.entrances.size();
+
+    for (size_t j = 0; j < num_entrances; ++j) {
+      relax(cell, cluster.entrances[j],
+            current.first + cluster.costs[i * num_entrances + j]);
+    }
+    for (const Cell to : cluster.crossings[i]) {
+      relax(cell, to, current.first + costMap_.getCost(to) + 1.0);
+    }
+
+    if (index == end_index) {
+      // Path cost from entrance to end: end_explored includes the entrance
+      // cost instead of the current cell cost.
+      relax(cell, end,
+            current.first +
+                explored_cost(end_cluster, scratch.end_explored, cell) -
+                costMap_.getCost(cell));
+    }
+  }
+
+  const double cost = nodes[nodeId(end, start)].cost;
+  if (std::isinf(cost)) {
+    return INF;
+  }
+
+  // Abstract path, start -> end.
+  std::vector<Cell> &abstract_path = scratch.abstract_path;
+  abstract_path.clear();
+  for (Cell current = end; current != start;) {
+    abstract_path.push_back(current);
+    current = *nodes[nodeId(current, start)].parent;
+  }
+  abstract_path.push_back(start);
+  std::reverse(abstract_path.begin(), abstract_path.end());
+
+  // Refine each abstract edge inside its cluster.
+  path.push_back(start);
+  for (size_t i = 1; i < abstract_path.size(); ++i) {
+    const Cell from = abstract_path[i - 1];
+    const Cell to = abstract_path[i];
+    const int index = clusterIndex(from);
+    if (index == clusterIndex(to)) {
+      refineInCluster(clusters_[index], from, to, path, scratch);
+    } else {
+      path.push_back(to);
+    }
+  }
+
+  return cost;
+}
@@ -0,0 +1,318 @@
+#include "jump_point_planner.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+namespace {
+
+const double SQRT_2 = std::sqrt(2.0);
+
+static const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+static const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+bool isOpen(Map2D<float> const &costMap, int row, int col) {
+  if (row < 0 || row >= costMap.getHeight()) {
+    return false;
+  }
+  if (col < 0 || col >= costMap.getWidth()) {
+    return false;
+  }
+  return !std::isinf(costMap.getCost(Cell(row, col)));
+}
+
+/** True if cell can step in (step_r, step_c) without cutting corners. */
+bool canStep(Map2D<float> const &costMap, Cell cell, int step_r, int step_c) {
+  if (!isOpen(costMap, cell.row + step_r, cell.col + step_c)) {
+    return false;
+  }
+  if (step_r != 0 && step_c != 0) {
+    return isOpen(costMap, cell.row + step_r, cell.col) &&
+           isOpen(costMap, cell.row, cell.col + step_c);
+  }
+  return true;
+}
+
+/**
+ * True if an open neighbor of cell has a different cost. These cells are
+ * always jump points and are expanded in all directions, since JPS pruning
+ * assumes uniform cost.
+ */
+bool isNextToWeight(Map2D<float> const &costMap, Cell cell) {
+  const float cost = costMap.getCost(cell);
+  for (int i = 0; i < 8; ++i) {
+    const int row = cell.row + dr[i];
+    const int col = cell.col + dc[i];
+    if (isOpen(costMap, row, col) && costMap.getCost(Cell(row, col)) != cost) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * True if the side cell (perpendicular to a straight move in (step_r,
+ * step_c)) can only be reached optimally through cell: the side cell is open
+ * but the cell behind it is blocked.
+ */
+bool hasForcedNeighbor(Map2D<float> const &costMap, Cell cell, int step_r,
+                       int step_c, int side) {
+  const int side_r = step_r == 0 ? side : 0;
+  const int side_c = step_c == 0 ? side : 0;
+  return isOpen(costMap, cell.row + side_r, cell.col + side_c) &&
+         !isOpen(costMap, cell.row + side_r - step_r,
+                 cell.col + side_c - step_c);
+}
+
+/**
+ * Lower bound on cost: octile distance, plus the cheapest cell cost for each
+ * cell entered. Every move travels at least its octile distance and enters
+ * one cell, so this is consistent.
+ */
+double heuristic(Cell from, Cell to, float min_cost) {
+  const int rows = std::abs(to.row - from.row);
+  const int cols = std::abs(to.col - from.col);
+  return std::abs(rows - cols) + SQRT_2 * std::min(rows, cols) +
+         min_cost * std::max(rows, cols);
+}
+
+int sign(int value) { return (value > 0) - (value < 0); }
+
+struct Jump {
+  Cell cell;
+  // Cost of the cells entered and distance travelled, excluding the start.
+  double cost;
+};
+
+/**
+ * Walks from cell in direction (step_r, step_c) until reaching a jump point:
+ * the goal, a cell next to a different cost, a cell with a forced neighbor,
+ * or (for diagonals) a cell from which a straight jump finds a jump point.
+ */
+std::optional<Jump> jump(Map2D<float> const &costMap, Cell cell, int step_r,
+                         int step_c, Cell end) {
+  const bool diagonal = step_r != 0 && step_c != 0;
+  const double step_travel = diagonal ? SQRT_2 : 1.0;
+
+  double cost = 0.0;
+  while (canStep(costMap, cell, step_r, step_c)) {
+    cell = Cell(cell.row + step_r, cell.col + step_c);
+    cost += costMap.getCost(cell) + step_travel;
+
+    if (cell == end || isNextToWeight(costMap, cell)) {
+      return Jump{cell, cost};
+    }
+    if (diagonal) {
+      if (jump(costMap, cell, step_r, 0, end) ||
+          jump(costMap, cell, 0, step_c, end)) {
+        return Jump{cell, cost};
+      }
+    } else if (hasForcedNeighbor(costMap, cell, step_r, step_c, -1) ||
+               hasForcedNeighbor(costMap, cell, step_r, step_c, 1)) {
+      return Jump{cell, cost};
+    }
+  }
+  return std::nullopt;
+}
+
+/** One step in direction (step_r, step_c), if allowed. */
+std::optional<Jump> step(Map2D<float> const &costMap, Cell cell, int step_r,
+                         int step_c) {
+  if (!canStep(costMap, cell, step_r, step_c)) {
+    return std::nullopt;
+  }
+  const Cell next(cell.row + step_r, cell.col + step_c);
+  return Jump{next, costMap.getCost(next) + impl::travelCost(cell, next)};
+}
+
+// Priority and cell.
+using PathCostToCell = std::pair<double, Cell>;
+
+// Min-heap on priority.
+bool heapCompare(PathCostToCell const &p1, PathCostToCell const &p2) {
+  return p1.first > p2.first;
+}
+
+/** Fills in the straight-line cells between consecutive jump points. */
+void fillSegments(std::vector<Cell> const &jump_points,
+                  std::vector<Cell> &path) {
+  path.clear();
+  if (jump_points.empty()) {
+    return;
+  }
+
+  path.push_back(jump_points.front());
+  for (size_t i = 1; i < jump_points.size(); ++i) {
+    const int step_r = sign(jump_points[i].row - jump_points[i - 1].row);
+    const int step_c = sign(jump_points[i].col - jump_points[i - 1].col);
+    Cell current = jump_points[i - 1];
+    while (current != jump_points[i]) {
+      current = Cell(current.row + step_r, current.col + step_c);
+      path.push_back(current);
+    }
+  }
+}
+
+/** A* search. With use_jumps, successors are found with JPS. */
+double search(Cell start, Cell end, Map2D<float> const &costMap,
+              std::vector<Cell> &path, float min_cost, PlannerScratch &scratch,
+              PlannerStats *stats, bool use_jumps) {
+  PlannerStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+
+  // Also covers a fully blocked map, where min_cost is +inf and the heuristic
+  // would be NaN.
+  path.clear();
+  if (std::isinf(costMap.getCost(start)) || std::isinf(costMap.getCost(end))) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  scratch.reset();
+  Map2D<impl::CellCostAndParent> &explored_map = scratch.explored;
+  std::vector<PathCostToCell> &queue = scratch.heap;
+
+  double start_cost = costMap.getCost(start);
+  explored_map.getCost(start).cost = start_cost;
+  scratch.touched.push_back(start);
+  queue.emplace_back(start_cost + heuristic(start, end, min_cost), start);
+  ++stats->heap_pushes;
+
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), heapCompare);
+    const PathCostToCell current = queue.back();
+    queue.pop_back();
+    ++stats->heap_pops;
+
+    const Cell current_cell = current.second;
+    const impl::CellCostAndParent &explored =
+        explored_map.getCost(current_cell);
+
+    // Check if we've already processed this cell with a lower cost.
+    if (current.first >
+        explored.cost + heuristic(current_cell, end, min_cost)) {
+      continue;
+    }
+    ++stats->expansions;
+
+    if (current_cell == end) {
+      break;
+    }
+
+    // Pruned directions: "natural" and forced neighbors, given the direction
+    // we arrived from.
+    int directions[8][2];
+    int num_directions = 0;
+    auto add_direction = [&](int step_r, int step_c) {
+      directions[num_directions][0] = step_r;
+      directions[num_directions++][1] = step_c;
+    };
+    if (use_jumps && explored.parent &&
+        !isNextToWeight(costMap, current_cell)) {
+      const int from_r = sign(current_cell.row - explored.parent->row);
+      const int from_c = sign(current_cell.col - explored.parent->col);
+      add_direction(from_r, from_c);
+      if (from_r != 0 && from_c != 0) {
+        add_direction(from_r, 0);
+        add_direction(0, from_c);
+      } else {
+        for (int side : {-1, 1}) {
+          if (hasForcedNeighbor(costMap, current_cell, from_r, from_c, side)) {
+            add_direction(from_r == 0 ? side : 0, from_c == 0 ? side : 0);
+            add_direction(from_r == 0 ? side : from_r,
+                          from_c == 0 ? side : from_c);
+          }
+        }
+      }
+    } else {
+      for (int i = 0; i < 8; ++i) {
+        add_direction(dr[i], dc[i]);
+      }
+    }
+
+    const double current_cost = explored.cost;
+    for (int i = 0; i < num_directions; ++i) {
+      const std::optional<Jump> next =
+          use_jumps ? jump(costMap, current_cell, directions[i][0],
+                           directions[i][1], end)
+                    : step(costMap, current_cell, directions[i][0],
+                           directions[i][1]);
+      if (!next) {
+        continue;
+      }
+
+      const double next_cost = current_cost + next->cost;
+      impl::CellCostAndParent &next_explored = explored_map.getCost(next->cell);
+      if (next_cost >= next_explored.cost) {
+        continue;
+      }
+
+      if (std::isinf(next_explored.cost)) {
+        scratch.touched.push_back(next->cell);
+      }
+      next_explored.cost = next_cost;
+      next_explored.parent = current_cell;
+      queue.emplace_back(next_cost + heuristic(next->cell, end, min_cost),
+                         next->cell);
+      std::push_heap(queue.begin(), queue.end(), heapCompare);
+      ++stats->heap_pushes;
+    }
+  }
+
+  std::vector<Cell> jump_points;
+  double cost =
+      impl::findPathFromExploration(start, end, explored_map, jump_points);
+  fillSegments(jump_points, path);
+  return cost;
+}
+
+}  // namespace
+
+float minCellCost(Map2D<float> const &costMap) {
+  float min_cost = std::numeric_limits<float>::infinity();
+  for (int row = 0; row < costMap.getHeight(); ++row) {
+    for (int col = 0; col < costMap.getWidth(); ++col) {
+      min_cost = std::min(min_cost, costMap.getCost(Cell(row, col)));
+    }
+  }
+  return min_cost;
+}
+
+double computeJumpPointPath(Cell start, Cell end, Map2D<float> const &costMap,
+                            std::vector<Cell> &path, PlannerStats *stats) {
+  PlannerScratch scratch(costMap.getWidth(), costMap.getHeight());
+  return computeJumpPointPath(start, end, costMap, path, minCellCost(costMap),
+                              scratch, stats);
+}
+
+double computeJumpPointPath(Cell start, Cell end, Map2D<float> const &costMap,
+                            std::vector<Cell> &path, float minCost,
+                            PlannerScratch &scratch, PlannerStats *stats) {
+  return search(start, end, costMap, path, minCost, scratch, stats,
+                /*use_jumps=*/true);
+}
+
+namespace impl {
+
+double computeAStarPath(Cell start, Cell end, Map2D<float> const &costMap,
+                        std::vector<Cell> &path, PlannerStats *stats) {
+  PlannerScratch scratch(costMap.getWidth(), costMap.getHeight());
+  return computeAStarPath(start, end, costMap, path, minCellCost(costMap),
+                          scratch, stats);
+}
+
+double computeAStarPath(Cell start, Cell end, Map2D<float> const &costMap,
+                        std::vector<Cell> &path, float minCost,
+                        PlannerScratch &scratch, PlannerStats *stats) {
+  return search(start, end, costMap, path, minCost, scratch, stats,
+                /*use_jumps=*/false);
+}
+
+}  // namespace impl
@@ -0,0 +1,203 @@
+#include "landmark_planner.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace {
+
+struct PathCostToCell {
+  // Cost so far plus heuristic.
+  double priority;
+  // Cost so far, to skip stale entries.
+  double cost;
+  Cell cell;
+
+  PathCostToCell(double _priority, double _cost, Cell _cell)
+      : priority(_priority), cost(_cost), cell(_cell) {}
+};
+
+// std::greater
+bool operator>(PathCostToCell const &p1, PathCostToCell const &p2) {
+  return p1.priority > p2.priority;
+}
+
+}  // namespace
+
+LandmarkPlanner::LandmarkPlanner(Map2D<float> const &costMap,
+                                 int numLandmarks, PlannerMode mode)
+    : costMap_(costMap), mode_(mode) {
+  assert(mode != PlannerMode::ANY_ANGLE);
+
+  const int width = costMap_.getWidth();
+  const int height = costMap_.getHeight();
+
+  // Min cost from the landmarks so far; +inf where none reaches.
+  std::vector<double> nearest(width * height,
+                              std::numeric_limits<double>::infinity());
+
+  // Seed the selection from any open cell: the first landmark is the cell
+  // farthest from it.
+  std::vector<double> seed_field;
+  for (int row = 0; row < height && seed_field.empty(); ++row) {
+    for (int col = 0; col < width && seed_field.empty(); ++col) {
+      if (!std::isinf(costMap_.getCost(Cell(row, col)))) {
+        const DistanceField field =
+            computeDistanceField(Cell(row, col), costMap_, mode_);
+        seed_field.resize(width * height);
+        for (int r = 0; r < height; ++r) {
+          for (int c = 0; c < width; ++c) {
+            seed_field[r * width + c] = field.getCost(Cell(r, c)).cost;
+          }
+        }
+      }
+    }
+  }
+  if (seed_field.empty()) {
+    return;  // Nothing is open.
+  }
+
+  std::vector<bool> is_landmark(width * height);
+  for (int i = 0; i < numLandmarks; ++i) {
+    // Open cell farthest from every landmark so far. Cells no landmark
+    // reaches count as farthest, so each connected region gets one.
+    std::vector<double> const &distances = i == 0 ? seed_field : nearest;
+    int best = -1;
+    double best_distance = -1.0;
+    for (int row = 0; row < height; ++row) {
+      for (int col = 0; col < width; ++col) {
+        const Cell cell(row, col);
+        const double distance = distances[index(cell)];
+        if (!std::isinf(costMap_.getCost(cell)) && !is_landmark[index(cell)] &&
+            (i > 0 || !std::isinf(distance)) && distance > best_distance) {
+          best = index(cell);
+          best_distance = distance;
+        }
+      }
+    }
+    if (best < 0) {
+      break;  // Every open cell is a landmark already.
+    }
+
+    is_landmark[best] = true;
+    landmarks_.push_back(Cell(best / width, best % width));
+    const DistanceField field =
+        computeDistanceField(landmarks_.back(), costMap_, mode_);
+    fields_.emplace_back(width * height);
+    for (int row = 0; row < height; ++row) {
+      for (int col = 0; col < width; ++col) {
+        const double cost = field.getCost(Cell(row, col)).cost;
+        fields_.back()[row * width + col] = cost;
+        nearest[row * width + col] = std::min(nearest[row * width + col], cost);
+      }
+    }
+  }
+}
+
+double LandmarkPlanner::heuristic(Cell cell, Cell end) const {
+  const double cell_cost = costMap_.getCost(cell);
+  const double end_cost = costMap_.getCost(end);
+  double result = 0.0;
+  for (auto const &field : fields_) {
+    const double to_cell = field[index(cell)];
+    const double to_end = field[index(end)];
+    if (std::isinf(to_cell) && std::isinf(to_end)) {
+      continue;  // Neither is reachable from this landmark.
+    }
+    // One side +inf: cell and end aren't connected, and the bound is +inf.
+    result = std::max(result, to_end - to_cell);
+    result = std::max(result, to_cell - to_end - cell_cost + end_cost);
+  }
+  return result;
+}
+
+size_t LandmarkPlanner::getMemoryBytes() const {
+  size_t bytes = 0;
+  for (auto const &field : fields_) {
+    bytes += field.size() * sizeof(double);
+  }
+  return bytes;
+}
+
+double LandmarkPlanner::computePath(Cell start, Cell end,
+                                    std::vector<Cell> &path,
+                                    PlannerStats *stats) const {
+  PlannerStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+  path.clear();
+
+  if (std::isinf(costMap_.getCost(start)) ||
+      std::isinf(costMap_.getCost(end)) || std::isinf(heuristic(start, end))) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  Map2D<impl::CellCostAndParent> explored_map(costMap_.getWidth(),
+                                              costMap_.getHeight());
+
+  std::priority_queue<PathCostToCell, std::vector<PathCostToCell>,
+                      std::greater<PathCostToCell> >
+      queue;
+
+  const double start_cost = costMap_.getCost(start);
+  explored_map.getCost(start).cost = start_cost;
+  queue.push(
+      PathCostToCell(start_cost + heuristic(start, end), start_cost, start));
+  ++stats->heap_pushes;
+
+  static const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+  static const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+  const int num_directions = mode_ == PlannerMode::FOUR_CONNECTED ? 4 : 8;
+  auto is_open = [&](int row, int col) {
+    return row >= 0 && row < costMap_.getHeight() && col >= 0 &&
+           col < costMap_.getWidth() &&
+           !std::isinf(costMap_.getCost(Cell(row, col)));
+  };
+
+  while (!queue.empty()) {
+    const PathCostToCell current = queue.top();
+    queue.pop();
+    ++stats->heap_pops;
+
+    // Check if we've already processed this cell with a lower cost.
+    if (current.cost > explored_map.getCost(current.cell).cost) {
+      continue;
+    }
+    ++stats->expansions;
+
+    if (current.cell == end) {
+      break;
+    }
+
+    for (int i = 0; i < num_directions; ++i) {
+      const int row = current.cell.row + dr[i];
+      const int col = current.cell.col + dc[i];
+      // Don't cut corners.
+      if (!is_open(row, col) ||
+          (i >= 4 && (!is_open(row, current.cell.col) ||
+                      !is_open(current.cell.row, col)))) {
+        continue;
+      }
+
+      const Cell n(row, col);
+      ++stats->relaxations;
+      const double neighbor_cost = current.cost + costMap_.getCost(n) +
+                                   impl::travelCost(current.cell, n);
+      impl::CellCostAndParent &explored = explored_map.getCost(n);
+      if (neighbor_cost >= explored.cost) {
+        continue;
+      }
+
+      explored.cost = neighbor_cost;
+      explored.parent = current.cell;
+      queue.push(
+          PathCostToCell(neighbor_cost + heuristic(n, end), neighbor_cost, n));
+      ++stats->heap_pushes;
+    }
+  }
+
+  return impl::findPathFromExploration(start, end, explored_map, path);
+}
@@ -0,0 +1,83 @@
+#include "map_file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <climits>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+const char MAGIC[8] = {'M', 'A', 'P', '2', 'D', 'F', '3', '2'};
+const int32_t VERSION = 1;
+
+struct MapFileHeader {
+  char magic[8];
+  int32_t version;
+  int32_t width;
+  int32_t height;
+  char reserved[12];
+};
+
+static_assert(sizeof(MapFileHeader) == 32, "header must stay 32 bytes");
+
+}  // namespace
+
+bool saveMapFile(std::string const &path, Map2D<float> const &costMap) {
+  MapFileHeader header = {};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.width = costMap.getWidth();
+  header.height = costMap.getHeight();
+
+  FILE *file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  ok = ok && std::fwrite(costMap.data(), sizeof(float), costMap.size(),
+                         file) == (size_t)costMap.size();
+  return std::fclose(file) == 0 && ok;
+}
+
+std::optional<const Map2D<float> > loadMapFile(std::string const &path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+
+  // Map2D indexes cells with int, so larger maps can't be addressed.
+  struct stat file_stat;
+  MapFileHeader header;
+  if (fstat(fd, &file_stat) != 0 ||
+      pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION || header.width <= 0 || header.height <= 0 ||
+      (int64_t)header.width * header.height > INT_MAX ||
+      (size_t)file_stat.st_size !=
+          sizeof(header) +
+              sizeof(float) * (size_t)header.width * header.height) {
+    close(fd);
+    return std::nullopt;
+  }
+
+  // Read-only: the map is returned const, so nothing writes through it.
+  const size_t length = file_stat.st_size;
+  void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after closing the file.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+
+  // Points at the values; unmaps the whole file when the last map is gone.
+  std::shared_ptr<float> values(
+      reinterpret_cast<float *>(static_cast<char *>(mapping) + sizeof(header)),
+      [mapping, length](float *) { munmap(mapping, length); });
+  return Map2D<float>(header.width, header.height, values);
+}
@@ -0,0 +1,95 @@
+#include "path_simplifier.hh"
+
+#include <cmath>
+#include <limits>
+
+#include "djikstra_planner.hh"
+
+std::vector<Cell> compressCollinear(std::vector<Cell> const &path) {
+  std::vector<Cell> result;
+  for (size_t i = 0; i < path.size(); ++i) {
+    // Skip path[i] if the segment from the last waypoint through it carries
+    // on in the same direction to the next cell.
+    if (i > 0 && i + 1 < path.size()) {
+      const Cell prev = result.back();
+      const int dr1 = path[i].row - prev.row, dc1 = path[i].col - prev.col;
+      const int dr2 = path[i + 1].row - path[i].row;
+      const int dc2 = path[i + 1].col - path[i].col;
+      if (dr1 * dc2 == dc1 * dr2 && dr1 * dr2 + dc1 * dc2 > 0) {
+        continue;
+      }
+    }
+    result.push_back(path[i]);
+  }
+  return result;
+}
+
+double simplifyPath(std::vector<Cell> const &path, Map2D<float> const &costMap,
+                    double maxRelativeIncrease, std::vector<Cell> &waypoints) {
+  waypoints.clear();
+  if (path.empty()) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // Fewer candidates for the shortcut search, at no cost.
+  const std::vector<Cell> points = compressCollinear(path);
+
+  // prefix[i]: cost along path from points[0] to points[i], excluding the
+  // first cell.
+  std::vector<double> prefix(points.size(), 0.0);
+  for (size_t i = 1; i < points.size(); ++i) {
+    prefix[i] =
+        prefix[i - 1] + impl::lineCost(costMap, points[i - 1], points[i]);
+  }
+
+  // Cost of the segment from points[from] to points[to], or +inf if it costs
+  // too much compared to the path it replaces.
+  auto shortcut_cost = [&](size_t from, size_t to) {
+    const double cost = impl::lineCost(costMap, points[from], points[to]);
+    const double limit =
+        (1.0 + maxRelativeIncrease) * (prefix[to] - prefix[from]);
+    // Slack for rounding: equal-cost segments sum in a different order.
+    if (cost > limit + 1e-9 * limit) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return cost;
+  };
+
+  double total = costMap.getCost(points[0]);
+  waypoints.push_back(points[0]);
+  size_t anchor = 0;
+  while (anchor + 1 < points.size()) {
+    // Gallop, then binary search for the farthest point reachable in one
+    // segment. Every accepted segment is checked, so the bound holds even
+    // where shortcuts aren't monotone.
+    size_t good = anchor + 1;
+    double good_cost = prefix[good] - prefix[anchor];
+    size_t step = 1;
+    size_t bad = points.size();
+    while (good + step < points.size()) {
+      const double cost = shortcut_cost(anchor, good + step);
+      if (std::isinf(cost)) {
+        bad = good + step;
+        break;
+      }
+      good += step;
+      good_cost = cost;
+      step *= 2;
+    }
+    while (good + 1 < bad) {
+      const size_t mid = good + (bad - good) / 2;
+      const double cost = shortcut_cost(anchor, mid);
+      if (std::isinf(cost)) {
+        bad = mid;
+      } else {
+        good = mid;
+        good_cost = cost;
+      }
+    }
+
+    total += good_cost;
+    waypoints.push_back(points[good]);
+    anchor = good;
+  }
+  return total;
+}
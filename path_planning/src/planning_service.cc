@@ -0,0 +1,50 @@
+#include "planning_service.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+PlanningService::PlanningService(Map2D<float> const &costMap, int numWorkers)
+    : costMap_(costMap) {
+  if (numWorkers <= 0) {
+    numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < numWorkers; ++i) {
+    scratches_.push_back(std::make_unique<PlannerScratch>(
+        costMap_.getWidth(), costMap_.getHeight()));
+  }
+}
+
+std::vector<PathResult> PlanningService::computePaths(
+    std::vector<PathQuery> const &queries) {
+  std::vector<PathResult> results(queries.size());
+
+  // Workers pull the next query index, so slow queries don't hold up a
+  // fixed share of the batch.
+  std::atomic<size_t> next_query(0);
+  auto work = [&](PlannerScratch &scratch) {
+    for (size_t i = next_query++; i < queries.size(); i = next_query++) {
+      PathQuery const &query = queries[i];
+      results[i].cost = computePath(query.start, query.end, costMap_,
+                                    results[i].path, query.mode, scratch);
+    }
+  };
+
+  const size_t num_threads = std::min(scratches_.size(), queries.size());
+  if (num_threads <= 1) {
+    work(*scratches_[0]);
+    return results;
+  }
+
+  // The calling thread is worker 0.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work, std::ref(*scratches_[i]));
+  }
+  work(*scratches_[0]);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return results;
+}
@@ -0,0 +1,128 @@
+#include "coarse_to_fine_planner.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(downsampleCostMap, pooling) {
+  Map2D<float> cost_map(/*width=*/3, /*height=*/3,
+                        // Values packed row major.
+                        {1.0, 3.0, 2.0,  //
+                         INF, 2.0, INF,  //
+                         4.0, INF, 5.0});
+
+  const Map2D<float> max_map = downsampleCostMap(cost_map, Pooling::MAX);
+  ASSERT_EQ(2, max_map.getWidth());
+  ASSERT_EQ(2, max_map.getHeight());
+  EXPECT_EQ(3.0, max_map.getCost(Cell(0, 0)));
+  EXPECT_EQ(2.0, max_map.getCost(Cell(0, 1)));
+  EXPECT_EQ(4.0, max_map.getCost(Cell(1, 0)));
+  EXPECT_EQ(5.0, max_map.getCost(Cell(1, 1)));
+
+  const Map2D<float> mean_map = downsampleCostMap(cost_map, Pooling::MEAN);
+  EXPECT_EQ(2.0, mean_map.getCost(Cell(0, 0)));
+  EXPECT_EQ(2.0, mean_map.getCost(Cell(0, 1)));
+  EXPECT_EQ(4.0, mean_map.getCost(Cell(1, 0)));
+}
+
+// Only fully blocked blocks are blocked.
+TEST(downsampleCostMap, keepsNarrowGaps) {
+  Map2D<float> cost_map(/*width=*/4, /*height=*/4,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0,  //
+                         INF, INF, INF, 0.0,  // obstacle with a gap!
+                         INF, INF, INF, 0.0});
+
+  const Map2D<float> coarse = downsampleCostMap(cost_map, Pooling::MAX);
+  EXPECT_EQ(INF, coarse.getCost(Cell(1, 0)));
+  EXPECT_EQ(0.0, coarse.getCost(Cell(1, 1)));
+}
+
+TEST(buildCostMapPyramid, levelSizes) {
+  Map2D<float> cost_map(/*width=*/20, /*height=*/9);
+  const auto levels = buildCostMapPyramid(cost_map, 3, Pooling::MEAN);
+
+  ASSERT_EQ(3, levels.size());
+  EXPECT_EQ(10, levels[0].getWidth());
+  EXPECT_EQ(5, levels[0].getHeight());
+  EXPECT_EQ(5, levels[1].getWidth());
+  EXPECT_EQ(3, levels[1].getHeight());
+  EXPECT_EQ(3, levels[2].getWidth());
+  EXPECT_EQ(2, levels[2].getHeight());
+}
+
+TEST(CoarseToFinePlanner, openFieldIsOptimal) {
+  Map2D<float> cost_map(/*width=*/100, /*height=*/70);
+  cost_map.fill(1.0);
+  const Cell start(3, 2);
+  const Cell end(66, 97);
+
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED}) {
+    std::vector<Cell> expected_path;
+    double expected_cost =
+        computePath(start, end, cost_map, expected_path, mode);
+
+    CoarseToFinePlanner planner(cost_map, /*numCoarseLevels=*/3);
+    std::vector<Cell> path;
+    EXPECT_NEAR(expected_cost, planner.computePath(start, end, path, mode),
+                1e-9);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(start, path.front());
+    EXPECT_EQ(end, path.back());
+  }
+}
+
+// Random weighted maps: feasible when computePath is, never cheaper.
+TEST(CoarseToFinePlanner, randomMaps) {
+  const int size = 48;
+  Map2D<float> cost_map(size, size);
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.3 ? INF : 4.0 * value;
+    }
+  }
+
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  for (Pooling pooling : {Pooling::MAX, Pooling::MEAN}) {
+    CoarseToFinePlanner planner(cost_map, /*numCoarseLevels=*/2, pooling,
+                                /*corridorRadius=*/1);
+    for (int i = 0; i < 100; ++i) {
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+
+      std::vector<Cell> expected_path;
+      double expected_cost = computePath(start, end, cost_map, expected_path);
+
+      std::vector<Cell> path;
+      double path_cost = planner.computePath(start, end, path);
+      if (std::isinf(expected_cost)) {
+        EXPECT_EQ(INF, path_cost);
+        EXPECT_TRUE(path.empty());
+        continue;
+      }
+      EXPECT_GE(path_cost, expected_cost - 1e-9);
+
+      ASSERT_FALSE(path.empty());
+      EXPECT_EQ(start, path.front());
+      EXPECT_EQ(end, path.back());
+      double total = cost_map.getCost(path[0]);
+      for (size_t j = 1; j < path.size(); ++j) {
+        EXPECT_EQ(1, std::abs(path[j].row - path[j - 1].row) +
+                         std::abs(path[j].col - path[j - 1].col));
+        total += cost_map.getCost(path[j]) + 1.0;
+      }
+      EXPECT_NEAR(path_cost, total, 1e-9);
+    }
+  }
+}
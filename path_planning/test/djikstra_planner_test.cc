@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <random>
+
 #include "map_2d.hh"
 
 static const float INF = std::numeric_limits<float>::infinity();
@@ -148,3 +151,405 @@ TEST(computePath, blockedGraph) {
   EXPECT_EQ(start, path[0]);
   EXPECT_EQ(end2, path[3]);
 }
+
+TEST(computePath, eightConnectedDiagonal) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5);
+  cost_map.fill(0.0);
+
+  const Cell start(0, 0);
+  const Cell end(4, 4);
+
+  std::vector<Cell> path;
+  double path_cost =
+      computePath(start, end, cost_map, path, PlannerMode::EIGHT_CONNECTED);
+
+  EXPECT_DOUBLE_EQ(4 * std::sqrt(2.0), path_cost);
+  ASSERT_EQ(5, path.size());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(Cell(i, i), path[i]);
+  }
+}
+
+// Diagonal moves can't squeeze between two obstacles touching at a corner.
+TEST(computePath, eightConnectedNoCornerCutting) {
+  Map2D<float> cost_map(/*width=*/2, /*height=*/2,
+                        // Values packed row major.
+                        {0.0, INF,  //
+                         INF, 0.0});
+
+  std::vector<Cell> path;
+  double path_cost = computePath(Cell(0, 0), Cell(1, 1), cost_map, path,
+                                 PlannerMode::EIGHT_CONNECTED);
+
+  EXPECT_EQ(INF, path_cost);
+  EXPECT_EQ(0, path.size());
+}
+
+TEST(computePath, anyAngleOpenField) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/3);
+  cost_map.fill(0.0);
+
+  const Cell start(0, 0);
+  const Cell end(2, 4);
+
+  std::vector<Cell> eight_path;
+  double eight_cost = computePath(start, end, cost_map, eight_path,
+                                  PlannerMode::EIGHT_CONNECTED);
+  EXPECT_DOUBLE_EQ(2 + 2 * std::sqrt(2.0), eight_cost);
+
+  // Straight line, no intermediate waypoints.
+  std::vector<Cell> path;
+  double path_cost =
+      computePath(start, end, cost_map, path, PlannerMode::ANY_ANGLE);
+
+  EXPECT_DOUBLE_EQ(std::sqrt(20.0), path_cost);
+  EXPECT_LT(path_cost, eight_cost);
+  ASSERT_EQ(2, path.size());
+  EXPECT_EQ(start, path[0]);
+  EXPECT_EQ(end, path[1]);
+}
+
+// Any-angle path wraps around the obstacle and every segment is clear.
+TEST(computePath, anyAngleObstacleGraph) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, INF, INF, INF, 0.0,  // obstacle!
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0});
+
+  const Cell start(0, 2);
+  const Cell end(4, 2);
+
+  std::vector<Cell> four_path;
+  double four_cost = computePath(start, end, cost_map, four_path);
+
+  std::vector<Cell> path;
+  double path_cost =
+      computePath(start, end, cost_map, path, PlannerMode::ANY_ANGLE);
+
+  EXPECT_LT(path_cost, four_cost);
+  EXPECT_LT(path.size(), four_path.size());
+  ASSERT_GE(path.size(), 3);
+  EXPECT_EQ(start, path.front());
+  EXPECT_EQ(end, path.back());
+
+  double segments_cost = cost_map.getCost(start);
+  for (size_t i = 1; i < path.size(); ++i) {
+    segments_cost += impl::lineCost(cost_map, path[i - 1], path[i]);
+  }
+  EXPECT_DOUBLE_EQ(path_cost, segments_cost);
+}
+
+TEST(lineCost, sumsCrossedCells) {
+  Map2D<float> cost_map(/*width=*/4, /*height=*/1, {1.0, 2.0, 3.0, 4.0});
+
+  EXPECT_DOUBLE_EQ(3.0 + 2.0 + 3.0 + 4.0,
+                   impl::lineCost(cost_map, Cell(0, 0), Cell(0, 3)));
+  EXPECT_DOUBLE_EQ(1.0 + 1.0, impl::lineCost(cost_map, Cell(0, 1), Cell(0, 0)));
+}
+
+TEST(lineCost, blockedByObstacle) {
+  Map2D<float> cost_map(/*width=*/3, /*height=*/3,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0,  //
+                         0.0, INF, 0.0,  //
+                         0.0, 0.0, 0.0});
+
+  EXPECT_EQ(INF, impl::lineCost(cost_map, Cell(0, 0), Cell(2, 2)));
+  EXPECT_EQ(INF, impl::lineCost(cost_map, Cell(0, 1), Cell(2, 1)));
+  EXPECT_DOUBLE_EQ(2.0, impl::lineCost(cost_map, Cell(0, 0), Cell(0, 2)));
+}
+
+TEST(computeDistanceField, matchesComputePath) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 100, 100, 100, 0.0,  //
+                         0.0, 0.0, 100, 0.0, 0.0,  //
+                         100, 0.0, 0.0, 0.0, 100,  //
+                         100, 0.0, INF, 0.0, 100,  //
+                         100, 0.0, 0.0, 0.0, 100});
+
+  const Cell start(0, 0);
+  const DistanceField field = computeDistanceField(start, cost_map);
+
+  for (int row = 0; row < 5; ++row) {
+    for (int col = 0; col < 5; ++col) {
+      const Cell end(row, col);
+      std::vector<Cell> expected_path;
+      double expected_cost = computePath(start, end, cost_map, expected_path);
+
+      std::vector<Cell> path;
+      EXPECT_EQ(expected_cost, findPathInField(field, end, path));
+      EXPECT_EQ(expected_path.size(), path.size());
+    }
+  }
+}
+
+// Each cell gets the cost from its cheapest source.
+TEST(computeDistanceField, multiSource) {
+  Map2D<float> cost_map(/*width=*/7, /*height=*/1);
+  cost_map.fill(0.0);
+
+  const DistanceField field =
+      computeDistanceField({Cell(0, 0), Cell(0, 6)}, cost_map);
+
+  EXPECT_EQ(0.0, field.getCost(Cell(0, 0)).cost);
+  EXPECT_EQ(2.0, field.getCost(Cell(0, 2)).cost);
+  EXPECT_EQ(3.0, field.getCost(Cell(0, 3)).cost);
+  EXPECT_EQ(1.0, field.getCost(Cell(0, 5)).cost);
+
+  std::vector<Cell> path;
+  EXPECT_EQ(2.0, findPathInField(field, Cell(0, 4), path));
+  ASSERT_EQ(3, path.size());
+  EXPECT_EQ(Cell(0, 6), path[0]);
+  EXPECT_EQ(Cell(0, 4), path[2]);
+}
+
+TEST(computeCostMatrix, matchesComputePath) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 3.0, 0.0, 1.0, 0.0,  //
+                         INF, INF, INF, 2.0, INF,  // obstacle!
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0});
+
+  const std::vector<Cell> few = {Cell(0, 0), Cell(4, 4)};
+  const std::vector<Cell> many = {Cell(0, 4), Cell(1, 1), Cell(3, 0),
+                                  Cell(4, 2), Cell(2, 3)};
+
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED}) {
+    // Both expansion directions.
+    for (bool few_starts : {true, false}) {
+      const auto &starts = few_starts ? few : many;
+      const auto &ends = few_starts ? many : few;
+      const auto matrix = computeCostMatrix(starts, ends, cost_map, mode);
+
+      ASSERT_EQ(starts.size(), matrix.size());
+      for (size_t i = 0; i < starts.size(); ++i) {
+        ASSERT_EQ(ends.size(), matrix[i].size());
+        for (size_t j = 0; j < ends.size(); ++j) {
+          std::vector<Cell> path;
+          EXPECT_NEAR(computePath(starts[i], ends[j], cost_map, path, mode),
+                      matrix[i][j], 1e-9);
+        }
+      }
+    }
+  }
+}
+
+// Stopping at the ends gives the same costs as a full expansion, in every
+// mode. Theta* costs can drop after expansion, so ANY_ANGLE doesn't stop.
+TEST(computeCosts, matchesDistanceField) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int round = 0; round < 100; ++round) {
+    // Mixed cheap and expensive cells make Theta* shortcuts likely.
+    const int size = 16 + round % 16;
+    Map2D<float> cost_map(size, size);
+    for (int row = 0; row < size; ++row) {
+      for (int col = 0; col < size; ++col) {
+        const float cost = uniform(rng) < 0.5 ? 1.0 : 10.0;
+        cost_map.getCost(Cell(row, col)) =
+            round % 2 == 1 && uniform(rng) < 0.1 ? INF : cost;
+      }
+    }
+    std::uniform_int_distribution<int> random_coord(0, size - 1);
+    const Cell start(random_coord(rng), random_coord(rng));
+    cost_map.getCost(start) = 0.0;
+    std::vector<Cell> ends;
+    for (int i = 0; i < 5; ++i) {
+      ends.push_back(Cell(random_coord(rng), random_coord(rng)));
+    }
+
+    for (PlannerMode mode :
+         {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED,
+          PlannerMode::ANY_ANGLE}) {
+      const DistanceField field = computeDistanceField(start, cost_map, mode);
+      // One end at a time, so the expansion stops as early as it can.
+      for (const Cell end : ends) {
+        EXPECT_EQ(field.getCost(end).cost,
+                  computeCosts(start, {end}, cost_map, mode)[0]);
+      }
+    }
+  }
+}
+
+// Reused scratch gives the same result as a fresh one.
+TEST(computePath, reusedScratch) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 3.0, 0.0, 1.0, 0.0,  //
+                         INF, INF, INF, 2.0, INF,  // obstacle!
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0});
+
+  PlannerScratch scratch(cost_map.getWidth(), cost_map.getHeight());
+  for (const Cell start : {Cell(0, 0), Cell(4, 4), Cell(1, 3)}) {
+    for (const Cell end : {Cell(4, 0), Cell(0, 4), Cell(2, 3)}) {
+      std::vector<Cell> expected_path;
+      double expected_cost = computePath(start, end, cost_map, expected_path);
+
+      std::vector<Cell> path;
+      EXPECT_EQ(expected_cost,
+                computePath(start, end, cost_map, path,
+                            PlannerMode::FOUR_CONNECTED, scratch));
+      EXPECT_EQ(expected_path, path);
+    }
+  }
+}
+
+// Same paths on a tiled map, including cells in the padding tiles' rows/cols.
+TEST(computePath, tiledLayout) {
+  const int width = 13, height = 11;
+  Map2D<float> cost_map(width, height);
+  Map2D<float, TiledLayout<> > tiled_map(width, height);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.2 ? INF : 3.0 * value;
+      tiled_map.getCost(Cell(row, col)) = cost_map.getCost(Cell(row, col));
+    }
+  }
+
+  BasicPlannerScratch<TiledLayout<> > scratch(width, height);
+  std::uniform_int_distribution<int> random_row(0, height - 1);
+  std::uniform_int_distribution<int> random_col(0, width - 1);
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED,
+        PlannerMode::ANY_ANGLE}) {
+    for (int i = 0; i < 20; ++i) {
+      const Cell start(random_row(rng), random_col(rng));
+      const Cell end(random_row(rng), random_col(rng));
+
+      std::vector<Cell> expected_path;
+      double expected_cost =
+          computePath(start, end, cost_map, expected_path, mode);
+
+      std::vector<Cell> path;
+      EXPECT_EQ(expected_cost,
+                computePath(start, end, tiled_map, path, mode, scratch));
+      EXPECT_EQ(expected_path, path);
+    }
+  }
+}
+
+TEST(computePath, fillsStats) {
+  Map2D<float> cost_map(/*width=*/8, /*height=*/8);
+  cost_map.fill(1.0);
+
+  PlannerStats stats;
+  std::vector<Cell> path;
+  computePath(Cell(0, 0), Cell(7, 7), cost_map, path,
+              PlannerMode::EIGHT_CONNECTED, &stats);
+
+  EXPECT_GT(stats.expansions, 0);
+  EXPECT_EQ(stats.heap_pops, stats.expansions + stats.stalePops());
+  EXPECT_GE(stats.relaxations, stats.heap_pushes - 1);
+  EXPECT_GT(stats.heap_peak_size, 0);
+  EXPECT_LE(stats.heap_peak_size, stats.heap_pushes);
+  EXPECT_GE(stats.search_ms, 0.0);
+  EXPECT_GE(stats.path_ms, 0.0);
+}
+
+TEST(computeBidirectionalPath, oneCellGraph) {
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  cost_map.fill(2.0);
+
+  std::vector<Cell> path;
+  EXPECT_EQ(2.0, computeBidirectionalPath(Cell(0, 0), Cell(0, 0), cost_map,
+                                          path));
+  ASSERT_EQ(1, path.size());
+  EXPECT_EQ(Cell(0, 0), path[0]);
+}
+
+TEST(computeBidirectionalPath, blockedGraph) {
+  Map2D<float> cost_map(/*width=*/3, /*height=*/3,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0,  //
+                         INF, INF, INF,  // obstacle!
+                         0.0, 0.0, 0.0});
+
+  std::vector<Cell> path;
+  EXPECT_EQ(INF,
+            computeBidirectionalPath(Cell(0, 0), Cell(2, 2), cost_map, path));
+  EXPECT_TRUE(path.empty());
+}
+
+// Random weighted maps, every pair of modes and query, same cost as
+// computePath.
+TEST(computeBidirectionalPath, matchesComputePath) {
+  const int size = 24;
+  Map2D<float> cost_map(size, size);
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.25 ? INF : 3.0 * value;
+    }
+  }
+
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED}) {
+    for (int i = 0; i < 100; ++i) {
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+
+      std::vector<Cell> expected_path;
+      double expected_cost =
+          computePath(start, end, cost_map, expected_path, mode);
+
+      std::vector<Cell> path;
+      double path_cost =
+          computeBidirectionalPath(start, end, cost_map, path, mode);
+      if (std::isinf(expected_cost)) {
+        EXPECT_EQ(INF, path_cost);
+        EXPECT_TRUE(path.empty());
+        continue;
+      }
+      EXPECT_NEAR(expected_cost, path_cost, 1e-9);
+
+      // Path must be connected and add up to its cost.
+      ASSERT_FALSE(path.empty());
+      EXPECT_EQ(start, path.front());
+      EXPECT_EQ(end, path.back());
+      double total = cost_map.getCost(path[0]);
+      for (size_t j = 1; j < path.size(); ++j) {
+        EXPECT_LE(std::abs(path[j].row - path[j - 1].row), 1);
+        EXPECT_LE(std::abs(path[j].col - path[j - 1].col), 1);
+        total +=
+            cost_map.getCost(path[j]) + impl::travelCost(path[j - 1], path[j]);
+      }
+      EXPECT_NEAR(path_cost, total, 1e-9);
+    }
+  }
+}
+
+// Two circles of half the radius instead of one.
+TEST(computeBidirectionalPath, fewerExpansions) {
+  Map2D<float> cost_map(/*width=*/128, /*height=*/128);
+  cost_map.fill(1.0);
+  const Cell start(64, 34);
+  const Cell end(64, 94);
+
+  PlannerStats stats;
+  std::vector<Cell> path;
+  double expected_cost = computePath(start, end, cost_map, path,
+                                     PlannerMode::FOUR_CONNECTED, &stats);
+
+  PlannerStats bidirectional_stats;
+  EXPECT_NEAR(expected_cost,
+              computeBidirectionalPath(start, end, cost_map, path,
+                                       PlannerMode::FOUR_CONNECTED,
+                                       &bidirectional_stats),
+              1e-9);
+  EXPECT_LT(bidirectional_stats.expansions * 3, stats.expansions * 2);
+}
@@ -0,0 +1,124 @@
+#include "dstar_lite_planner.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(DStarLitePlanner, oneCellGraph) {
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  cost_map.fill(0.0);
+  DStarLitePlanner planner(cost_map, Cell(0, 0), Cell(0, 0));
+
+  std::vector<Cell> path;
+  EXPECT_EQ(0.0, planner.computePath(path));
+  ASSERT_EQ(1, path.size());
+  EXPECT_EQ(Cell(0, 0), path[0]);
+}
+
+TEST(DStarLitePlanner, obstacleAppears) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5);
+  cost_map.fill(0.0);
+
+  const Cell start(0, 2);
+  const Cell end(4, 2);
+  DStarLitePlanner planner(cost_map, start, end);
+
+  std::vector<Cell> path;
+  EXPECT_EQ(4.0, planner.computePath(path));
+  ASSERT_EQ(5, path.size());
+
+  // Same wall as computePath.obstacleGraph.
+  for (int col = 1; col <= 3; ++col) {
+    planner.updateCell(Cell(2, col), INF);
+  }
+  EXPECT_EQ(8.0, planner.computePath(path));
+  ASSERT_EQ(9, path.size());
+  EXPECT_EQ(start, path[0]);
+  EXPECT_EQ(end, path[8]);
+
+  // Blocked completely.
+  planner.updateCell(Cell(2, 0), INF);
+  planner.updateCell(Cell(2, 4), INF);
+  EXPECT_EQ(INF, planner.computePath(path));
+  EXPECT_EQ(0, path.size());
+
+  // And open again.
+  planner.updateCell(Cell(2, 2), 0.0);
+  EXPECT_EQ(4.0, planner.computePath(path));
+}
+
+// Random cost changes and start moves always match a full recomputation.
+TEST(DStarLitePlanner, matchesComputePath) {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> coord(0, 29);
+  std::uniform_real_distribution<float> cost(0.0, 4.0);
+  std::uniform_int_distribution<int> obstacle(0, 4);
+
+  Map2D<float> cost_map(/*width=*/30, /*height=*/30);
+  cost_map.fill(1.0);
+
+  Cell start(0, 0);
+  const Cell end(29, 29);
+  DStarLitePlanner planner(cost_map, start, end);
+
+  for (int round = 0; round < 30; ++round) {
+    for (int change = 0; change < 10; ++change) {
+      const Cell cell(coord(rng), coord(rng));
+      if (cell == start || cell == end) {
+        continue;
+      }
+      const float value = obstacle(rng) == 0 ? INF : cost(rng);
+      planner.updateCell(cell, value);
+      cost_map.getCost(cell) = value;
+    }
+
+    std::vector<Cell> expected_path;
+    double expected_cost = computePath(start, end, cost_map, expected_path);
+
+    PlannerStats stats;
+    std::vector<Cell> path;
+    double path_cost = planner.computePath(path, &stats);
+
+    if (std::isinf(expected_cost)) {
+      EXPECT_EQ(INF, path_cost);
+      continue;
+    }
+    ASSERT_NEAR(expected_cost, path_cost, 1e-6) << "round " << round;
+    ASSERT_GE(path.size(), 2);
+    EXPECT_EQ(start, path.front());
+    EXPECT_EQ(end, path.back());
+
+    double total = cost_map.getCost(start);
+    for (size_t i = 1; i < path.size(); ++i) {
+      total += cost_map.getCost(path[i]) + 1.0;
+    }
+    EXPECT_NEAR(path_cost, total, 1e-6);
+
+    // Drive one step along the path.
+    start = path[1];
+    planner.setStart(start);
+  }
+}
+
+// Repairing a small change expands far fewer cells than the first search.
+TEST(DStarLitePlanner, repairIsLocal) {
+  Map2D<float> cost_map(/*width=*/64, /*height=*/64);
+  cost_map.fill(0.0);
+  DStarLitePlanner planner(cost_map, Cell(0, 0), Cell(63, 63));
+
+  PlannerStats initial_stats;
+  std::vector<Cell> path;
+  planner.computePath(path, &initial_stats);
+
+  planner.updateCell(Cell(62, 60), INF);
+  PlannerStats repair_stats;
+  planner.computePath(path, &repair_stats);
+
+  EXPECT_LT(repair_stats.expansions * 10, initial_stats.expansions);
+}
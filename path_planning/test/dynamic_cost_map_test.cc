@@ -0,0 +1,169 @@
+#include "dynamic_cost_map.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(DynamicCostMap, snapshotsDontChange) {
+  Map2D<float> initial(/*width=*/10, /*height=*/6);
+  initial.fill(1.0);
+  DynamicCostMap costs(initial, /*tileSize=*/4);
+
+  const auto before = costs.getSnapshot();
+  EXPECT_EQ(0, before->version);
+
+  EXPECT_EQ(1, costs.update({{Cell(5, 9), 3.0}, {Cell(0, 0), INF}}));
+  const auto after = costs.getSnapshot();
+  EXPECT_EQ(1, after->version);
+  EXPECT_EQ(3.0, after->map.getCost(Cell(5, 9)));
+  EXPECT_EQ(INF, after->map.getCost(Cell(0, 0)));
+
+  EXPECT_EQ(1.0, before->map.getCost(Cell(5, 9)));
+  EXPECT_EQ(1.0, before->map.getCost(Cell(0, 0)));
+
+  // Held snapshots aren't reused.
+  costs.update({{Cell(5, 9), 4.0}});
+  costs.update({{Cell(5, 9), 5.0}});
+  EXPECT_EQ(1.0, before->map.getCost(Cell(5, 9)));
+  EXPECT_EQ(3.0, after->map.getCost(Cell(5, 9)));
+  EXPECT_EQ(5.0, costs.getSnapshot()->map.getCost(Cell(5, 9)));
+}
+
+// The initial map's storage is copied, so updates change neither it nor
+// held snapshots.
+TEST(DynamicCostMap, externalStorage) {
+  std::shared_ptr<float> storage(new float[4]{1.0, 1.0, 1.0, 1.0},
+                                 std::default_delete<float[]>());
+  const Map2D<float> initial(/*width=*/2, /*height=*/2, storage);
+  DynamicCostMap costs(initial, /*tileSize=*/1);
+
+  const auto v0 = costs.getSnapshot();
+  costs.update({{Cell(1, 1), 9.0}});
+  costs.update({{Cell(0, 0), 8.0}});
+  costs.update({{Cell(1, 1), 7.0}});
+  EXPECT_EQ(1.0, v0->map.getCost(Cell(1, 1)));
+  EXPECT_EQ(1.0, v0->map.getCost(Cell(0, 0)));
+  EXPECT_EQ(1.0, initial.getCost(Cell(1, 1)));
+  EXPECT_EQ(7.0, costs.getSnapshot()->map.getCost(Cell(1, 1)));
+}
+
+// Held snapshots keep their buffers; updates cycle through the free ones.
+TEST(DynamicCostMap, reusesFreeBuffers) {
+  Map2D<float> initial(/*width=*/10, /*height=*/6);
+  initial.fill(1.0);
+  DynamicCostMap costs(initial, /*tileSize=*/4);
+
+  const auto held_v0 = costs.getSnapshot();
+  costs.update({{Cell(0, 0), 2.0}});
+  const auto held_v1 = costs.getSnapshot();
+
+  std::set<float const *> buffers;
+  for (int i = 0; i < 10; ++i) {
+    costs.update({{Cell(i % 6, i), 3.0f + i}});
+    buffers.insert(costs.getSnapshot()->map.data());
+  }
+  EXPECT_EQ(2, buffers.size());
+  EXPECT_EQ(0, buffers.count(held_v0->map.data()));
+  EXPECT_EQ(0, buffers.count(held_v1->map.data()));
+  EXPECT_EQ(1.0, held_v0->map.getCost(Cell(0, 0)));
+  EXPECT_EQ(2.0, held_v1->map.getCost(Cell(0, 0)));
+  EXPECT_EQ(12.0, costs.getSnapshot()->map.getCost(Cell(3, 9)));
+}
+
+TEST(DynamicCostMap, changedTiles) {
+  Map2D<float> initial(/*width=*/10, /*height=*/6);
+  DynamicCostMap costs(initial, /*tileSize=*/4);
+
+  // 3 tiles per row, 2 rows.
+  costs.update({{Cell(0, 0), 1.0}, {Cell(5, 9), 1.0}});
+  costs.update({{Cell(4, 5), 1.0}});
+
+  const auto snapshot = costs.getSnapshot();
+  EXPECT_EQ(std::vector<int>({0, 4, 5}), snapshot->getChangedTiles(0));
+  EXPECT_EQ(std::vector<int>({4}), snapshot->getChangedTiles(1));
+  EXPECT_TRUE(snapshot->getChangedTiles(2).empty());
+
+  const auto bounds = snapshot->getTileBounds(5);
+  EXPECT_EQ(Cell(4, 8), bounds.first);
+  EXPECT_EQ(Cell(6, 10), bounds.second);
+}
+
+// Buffers rewritten by later updates stay in sync with every change.
+TEST(DynamicCostMap, matchesReference) {
+  const int size = 20;
+  Map2D<float> reference(size, size);
+  reference.fill(1.0);
+  DynamicCostMap costs(reference, /*tileSize=*/8);
+
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  std::uniform_real_distribution<float> value(0.0, 5.0);
+  for (int round = 0; round < 50; ++round) {
+    std::vector<std::pair<Cell, float> > changes;
+    for (int i = 0; i < 5; ++i) {
+      changes.push_back({Cell(coord(rng), coord(rng)), value(rng)});
+      reference.getCost(changes.back().first) = changes.back().second;
+    }
+    costs.update(changes);
+
+    const auto snapshot = costs.getSnapshot();
+    for (int row = 0; row < size; ++row) {
+      for (int col = 0; col < size; ++col) {
+        ASSERT_EQ(reference.getCost(Cell(row, col)),
+                  snapshot->map.getCost(Cell(row, col)));
+      }
+    }
+  }
+}
+
+// Each update fills a whole row; readers must never see a mixed row.
+TEST(DynamicCostMap, concurrentReaders) {
+  const int size = 32;
+  Map2D<float> initial(size, size);
+  DynamicCostMap costs(initial, /*tileSize=*/8);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> num_inconsistent(0);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        const auto snapshot = costs.getSnapshot();
+        for (int row = 0; row < size; ++row) {
+          const float first = snapshot->map.getCost(Cell(row, 0));
+          for (int col = 1; col < size; ++col) {
+            if (snapshot->map.getCost(Cell(row, col)) != first) {
+              ++num_inconsistent;
+            }
+          }
+        }
+        std::vector<Cell> path;
+        computePath(Cell(0, 0), Cell(size - 1, size - 1), snapshot->map, path);
+      }
+    });
+  }
+
+  for (int version = 1; version <= 200; ++version) {
+    std::vector<std::pair<Cell, float> > changes;
+    for (int col = 0; col < size; ++col) {
+      changes.push_back({Cell(version % size, col), (float)version});
+    }
+    costs.update(changes);
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(0, num_inconsistent);
+  EXPECT_EQ(200, costs.getSnapshot()->version);
+}
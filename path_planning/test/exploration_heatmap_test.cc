@@ -0,0 +1,49 @@
+#include "exploration_heatmap.hh"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(saveExplorationHeatmap, colorsExploredCells) {
+  Map2D<float> cost_map(/*width=*/3, /*height=*/2,
+                        // Values packed row major.
+                        {0.0, INF, 0.0,  //
+                         0.0, 0.0, 0.0});
+
+  // Explores (0, 0) and (1, 0) only.
+  PlannerScratch scratch(cost_map.getWidth(), cost_map.getHeight());
+  std::vector<Cell> path;
+  ASSERT_EQ(1.0, computePath(Cell(0, 0), Cell(1, 0), cost_map, path,
+                             PlannerMode::FOUR_CONNECTED, scratch));
+
+  const std::string file = testing::TempDir() + "heatmap_test_" +
+                           std::to_string(getpid()) + ".ppm";
+  ASSERT_TRUE(saveExplorationHeatmap(file, scratch.explored, cost_map));
+
+  std::ifstream in(file, std::ios::binary);
+  const std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+  std::remove(file.c_str());
+
+  const std::string header = "P6\n3 2\n255\n";
+  ASSERT_EQ(header.size() + 3 * 6, contents.size());
+  EXPECT_EQ(header, contents.substr(0, header.size()));
+
+  auto pixel = [&](int row, int col) {
+    return contents.substr(header.size() + 3 * (row * 3 + col), 3);
+  };
+  EXPECT_EQ(std::string("\x00\x00\xff", 3), pixel(0, 0));  // Cheapest.
+  EXPECT_EQ(std::string("\x00\x00\x00", 3), pixel(0, 1));  // Obstacle.
+  EXPECT_EQ(std::string("\xff\xff\xff", 3), pixel(0, 2));  // Unexplored.
+  EXPECT_EQ(std::string("\xff\x00\x00", 3), pixel(1, 0));  // Most expensive.
+}
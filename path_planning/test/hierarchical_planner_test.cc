@@ -0,0 +1,216 @@
+#include "hierarchical_planner.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+/** Checks that path is 4-connected, starts/ends correctly, and sums to cost. */
+static void expectValidPath(Cell start, Cell end, Map2D<float> const &cost_map,
+                            std::vector<Cell> const &path, double path_cost) {
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(start, path.front());
+  EXPECT_EQ(end, path.back());
+
+  double total = cost_map.getCost(path[0]);
+  for (size_t i = 1; i < path.size(); ++i) {
+    EXPECT_EQ(1, std::abs(path[i].row - path[i - 1].row) +
+                     std::abs(path[i].col - path[i - 1].col));
+    total += cost_map.getCost(path[i]) + 1.0;
+  }
+  EXPECT_NEAR(path_cost, total, 1e-6);
+}
+
+/** Random map with rectangular weighted patches and walls. */
+static Map2D<float> makeRandomMap(int size, std::mt19937 &rng) {
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  std::uniform_int_distribution<int> patch_size(1, size / 4);
+  std::uniform_real_distribution<float> patch_cost(0.0, 5.0);
+  std::uniform_int_distribution<int> obstacle(0, 2);
+
+  Map2D<float> cost_map(size, size);
+  cost_map.fill(0.5);
+  for (int patch = 0; patch < size / 2; ++patch) {
+    const int row = coord(rng);
+    const int col = coord(rng);
+    const int height = obstacle(rng) == 0 ? 1 : patch_size(rng);
+    const int width = patch_size(rng);
+    const float value = obstacle(rng) == 0 ? INF : patch_cost(rng);
+    for (int r = row; r < std::min(size, row + height); ++r) {
+      for (int c = col; c < std::min(size, col + width); ++c) {
+        cost_map.getCost(Cell(r, c)) = value;
+      }
+    }
+  }
+  return cost_map;
+}
+
+TEST(HierarchicalPlanner, oneCellGraph) {
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  cost_map.fill(0.0);
+  HierarchicalPlanner planner(cost_map, /*clusterSize=*/4);
+
+  std::vector<Cell> path;
+  double path_cost = planner.computePath(Cell(0, 0), Cell(0, 0), path);
+
+  EXPECT_EQ(0.0, path_cost);
+  ASSERT_EQ(1, path.size());
+  EXPECT_EQ(Cell(0, 0), path[0]);
+}
+
+TEST(HierarchicalPlanner, openField) {
+  Map2D<float> cost_map(/*width=*/64, /*height=*/48);
+  cost_map.fill(0.0);
+  HierarchicalPlanner planner(cost_map, /*clusterSize=*/8);
+  EXPECT_EQ(48, planner.getNumClusters());
+
+  const Cell start(1, 2);
+  const Cell end(45, 60);
+
+  std::vector<Cell> expected_path;
+  double expected_cost = computePath(start, end, cost_map, expected_path);
+
+  std::vector<Cell> path;
+  double path_cost = planner.computePath(start, end, path);
+
+  EXPECT_DOUBLE_EQ(expected_cost, path_cost);
+  expectValidPath(start, end, cost_map, path, path_cost);
+}
+
+// Same cluster, but the only route leaves the cluster.
+TEST(HierarchicalPlanner, detourThroughNeighborCluster) {
+  Map2D<float> cost_map(/*width=*/8, /*height=*/4,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         INF, INF, INF, INF, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, INF, INF, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+  HierarchicalPlanner planner(cost_map, /*clusterSize=*/4,
+                              /*entranceSpacing=*/1);
+
+  std::vector<Cell> path;
+  double path_cost = planner.computePath(Cell(0, 0), Cell(2, 0), path);
+
+  EXPECT_DOUBLE_EQ(12.0, path_cost);
+  expectValidPath(Cell(0, 0), Cell(2, 0), cost_map, path, path_cost);
+}
+
+TEST(HierarchicalPlanner, matchesDijkstraFeasibility) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> coord(0, 47);
+
+  for (int trial = 0; trial < 20; ++trial) {
+    Map2D<float> cost_map = makeRandomMap(48, rng);
+    HierarchicalPlanner planner(cost_map, /*clusterSize=*/8);
+    HierarchicalPlanner exact_planner(cost_map, /*clusterSize=*/8,
+                                      /*entranceSpacing=*/1);
+
+    for (int query = 0; query < 10; ++query) {
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+      if (std::isinf(cost_map.getCost(start)) ||
+          std::isinf(cost_map.getCost(end))) {
+        continue;
+      }
+
+      std::vector<Cell> expected_path;
+      double expected_cost = computePath(start, end, cost_map, expected_path);
+
+      std::vector<Cell> path;
+      double path_cost = planner.computePath(start, end, path);
+
+      if (std::isinf(expected_cost)) {
+        EXPECT_EQ(INF, path_cost);
+        EXPECT_EQ(0, path.size());
+        continue;
+      }
+
+      // Never cheaper than optimal.
+      EXPECT_GE(path_cost, expected_cost - 1e-6);
+      expectValidPath(start, end, cost_map, path, path_cost);
+
+      // Every border cell is an entrance: optimal.
+      std::vector<Cell> exact_path;
+      double exact_cost = exact_planner.computePath(start, end, exact_path);
+      EXPECT_NEAR(expected_cost, exact_cost, 1e-6);
+      expectValidPath(start, end, cost_map, exact_path, exact_cost);
+    }
+  }
+}
+
+// Reused scratch gives the same result as a fresh one, also after updateCells.
+TEST(HierarchicalPlanner, reusedScratch) {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> coord(0, 47);
+
+  Map2D<float> cost_map = makeRandomMap(48, rng);
+  HierarchicalPlanner planner(cost_map, /*clusterSize=*/8);
+  HierarchicalPlanner::Scratch scratch(planner);
+
+  for (int round = 0; round < 2; ++round) {
+    for (int query = 0; query < 20; ++query) {
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+
+      std::vector<Cell> expected_path;
+      double expected_cost = planner.computePath(start, end, expected_path);
+
+      std::vector<Cell> path;
+      EXPECT_EQ(expected_cost, planner.computePath(start, end, path, scratch));
+      EXPECT_EQ(expected_path, path);
+    }
+
+    // Open a column of cells, which changes the entrances of the clusters it
+    // crosses.
+    std::vector<Cell> changed;
+    for (int row = 0; row < 48; ++row) {
+      cost_map.getCost(Cell(row, 20)) = 0.0;
+      changed.push_back(Cell(row, 20));
+    }
+    planner.updateCells(changed);
+  }
+}
+
+TEST(HierarchicalPlanner, updateCellsRebuildsTouchedClusters) {
+  Map2D<float> cost_map(/*width=*/16, /*height=*/16);
+  cost_map.fill(0.0);
+  HierarchicalPlanner planner(cost_map, /*clusterSize=*/4,
+                              /*entranceSpacing=*/1);
+
+  const Cell start(0, 1);
+  const Cell end(15, 1);
+
+  std::vector<Cell> path;
+  EXPECT_DOUBLE_EQ(15.0, planner.computePath(start, end, path));
+
+  // Interior cell: only its own cluster.
+  cost_map.getCost(Cell(5, 5)) = 3.0;
+  EXPECT_EQ(1, planner.updateCells({Cell(5, 5)}));
+
+  // Wall across row 7, which borders the clusters below. Leave a gap at the
+  // right edge.
+  std::vector<Cell> wall;
+  for (int col = 0; col < 15; ++col) {
+    cost_map.getCost(Cell(7, col)) = INF;
+    wall.push_back(Cell(7, col));
+  }
+  EXPECT_EQ(8, planner.updateCells(wall));
+
+  std::vector<Cell> expected_path;
+  double expected_cost = computePath(start, end, cost_map, expected_path);
+
+  double path_cost = planner.computePath(start, end, path);
+  EXPECT_DOUBLE_EQ(expected_cost, path_cost);
+  expectValidPath(start, end, cost_map, path, path_cost);
+
+  // Close the gap.
+  cost_map.getCost(Cell(7, 15)) = INF;
+  planner.updateCells({Cell(7, 15)});
+  EXPECT_EQ(INF, planner.computePath(start, end, path));
+  EXPECT_EQ(0, path.size());
+}
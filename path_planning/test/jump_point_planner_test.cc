@@ -0,0 +1,174 @@
+#include "jump_point_planner.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+/** Checks that path is 8-connected, starts/ends correctly, and sums to cost. */
+static void expectValidPath(Cell start, Cell end, Map2D<float> const &cost_map,
+                            std::vector<Cell> const &path, double path_cost) {
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(start, path.front());
+  EXPECT_EQ(end, path.back());
+
+  double total = cost_map.getCost(path[0]);
+  for (size_t i = 1; i < path.size(); ++i) {
+    EXPECT_LE(std::abs(path[i].row - path[i - 1].row), 1);
+    EXPECT_LE(std::abs(path[i].col - path[i - 1].col), 1);
+    total += cost_map.getCost(path[i]) + impl::travelCost(path[i - 1], path[i]);
+  }
+  EXPECT_NEAR(path_cost, total, 1e-9);
+}
+
+TEST(computeJumpPointPath, oneCellGraph) {
+  const Cell start(0, 0);
+
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  cost_map.getCost(start) = 0.0;
+
+  std::vector<Cell> path;
+  double path_cost = computeJumpPointPath(start, start, cost_map, path);
+
+  EXPECT_EQ(0.0, path_cost);
+  ASSERT_EQ(1, path.size());
+  EXPECT_EQ(start, path[0]);
+}
+
+TEST(computeJumpPointPath, openField) {
+  Map2D<float> cost_map(/*width=*/64, /*height=*/64);
+  cost_map.fill(1.0);
+
+  const Cell start(3, 2);
+  const Cell end(60, 50);
+
+  std::vector<Cell> expected_path;
+  double expected_cost = computePath(start, end, cost_map, expected_path,
+                                     PlannerMode::EIGHT_CONNECTED);
+
+  PlannerStats astar_stats;
+  std::vector<Cell> astar_path;
+  double astar_cost =
+      impl::computeAStarPath(start, end, cost_map, astar_path, &astar_stats);
+
+  PlannerStats jps_stats;
+  std::vector<Cell> path;
+  double path_cost =
+      computeJumpPointPath(start, end, cost_map, path, &jps_stats);
+
+  EXPECT_NEAR(expected_cost, astar_cost, 1e-9);
+  EXPECT_NEAR(expected_cost, path_cost, 1e-9);
+  expectValidPath(start, end, cost_map, path, path_cost);
+
+  // Jumping skips the symmetric cells A* pushes.
+  EXPECT_LT(jps_stats.heap_pushes * 10, astar_stats.heap_pushes);
+}
+
+TEST(computeJumpPointPath, blockedGraph) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         INF, INF, INF, INF, INF,  // obstacle!
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0});
+
+  std::vector<Cell> path;
+  double path_cost =
+      computeJumpPointPath(Cell(0, 2), Cell(4, 2), cost_map, path);
+
+  EXPECT_EQ(INF, path_cost);
+  EXPECT_EQ(0, path.size());
+}
+
+// Every cell blocked: no heuristic to speak of (the min cost is +inf).
+TEST(computeJumpPointPath, fullyBlockedMap) {
+  Map2D<float> cost_map(/*width=*/2, /*height=*/2);
+  cost_map.fill(INF);
+  EXPECT_EQ(INF, minCellCost(cost_map));
+
+  std::vector<Cell> path;
+  EXPECT_EQ(INF, computeJumpPointPath(Cell(1, 1), Cell(1, 1), cost_map, path));
+  EXPECT_EQ(0, path.size());
+}
+
+// Reused scratch and a precomputed min cost give the same result as a fresh
+// query.
+TEST(computeJumpPointPath, reusedScratch) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {1.0, 1.0, 1.0, 1.0, 1.0,  //
+                         1.0, 3.0, 1.0, 1.0, 1.0,  //
+                         INF, INF, INF, 2.0, INF,  // obstacle!
+                         1.0, 1.0, 1.0, 1.0, 1.0,  //
+                         1.0, 1.0, 1.0, 1.0, 1.0});
+
+  const float min_cost = minCellCost(cost_map);
+  EXPECT_EQ(1.0, min_cost);
+
+  PlannerScratch scratch(cost_map.getWidth(), cost_map.getHeight());
+  for (const Cell start : {Cell(0, 0), Cell(4, 4), Cell(1, 3)}) {
+    for (const Cell end : {Cell(4, 0), Cell(0, 4), Cell(2, 3), Cell(2, 0)}) {
+      std::vector<Cell> expected_path;
+      double expected_cost =
+          computeJumpPointPath(start, end, cost_map, expected_path);
+
+      std::vector<Cell> path;
+      EXPECT_EQ(expected_cost, computeJumpPointPath(start, end, cost_map, path,
+                                                    min_cost, scratch));
+      EXPECT_EQ(expected_path, path);
+    }
+  }
+}
+
+// Uniform regions mixed with weighted patches and obstacles must give the same
+// cost as plain 8-connected Dijkstra.
+TEST(computeJumpPointPath, matchesDijkstraOnMixedMaps) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> coord(0, 39);
+  std::uniform_int_distribution<int> patch_size(1, 8);
+  std::uniform_real_distribution<float> patch_cost(0.0, 5.0);
+  std::uniform_int_distribution<int> obstacle(0, 3);
+
+  for (int trial = 0; trial < 20; ++trial) {
+    Map2D<float> cost_map(/*width=*/40, /*height=*/40);
+    cost_map.fill(0.5);
+
+    for (int patch = 0; patch < 15; ++patch) {
+      const int row = coord(rng);
+      const int col = coord(rng);
+      const int size = patch_size(rng);
+      const float value = obstacle(rng) == 0 ? INF : patch_cost(rng);
+      for (int r = row; r < std::min(40, row + size); ++r) {
+        for (int c = col; c < std::min(40, col + size); ++c) {
+          cost_map.getCost(Cell(r, c)) = value;
+        }
+      }
+    }
+
+    const Cell start(coord(rng), coord(rng));
+    const Cell end(coord(rng), coord(rng));
+    cost_map.getCost(start) = 0.5;
+    cost_map.getCost(end) = 0.5;
+
+    std::vector<Cell> expected_path;
+    double expected_cost = computePath(start, end, cost_map, expected_path,
+                                       PlannerMode::EIGHT_CONNECTED);
+
+    std::vector<Cell> path;
+    double path_cost = computeJumpPointPath(start, end, cost_map, path);
+
+    if (std::isinf(expected_cost)) {
+      EXPECT_EQ(INF, path_cost);
+      EXPECT_EQ(0, path.size());
+      continue;
+    }
+    EXPECT_NEAR(expected_cost, path_cost, 1e-6) << "trial " << trial;
+    expectValidPath(start, end, cost_map, path, path_cost);
+  }
+}
@@ -0,0 +1,121 @@
+#include "landmark_planner.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(LandmarkPlanner, oneCellGraph) {
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  cost_map.fill(1.0);
+  LandmarkPlanner planner(cost_map, /*numLandmarks=*/4);
+
+  EXPECT_EQ(1, planner.getLandmarks().size());
+  std::vector<Cell> path;
+  EXPECT_EQ(1.0, planner.computePath(Cell(0, 0), Cell(0, 0), path));
+  ASSERT_EQ(1, path.size());
+  EXPECT_EQ(Cell(0, 0), path[0]);
+}
+
+// Farthest-point selection starts in the corners of an open field.
+TEST(LandmarkPlanner, selectsFarLandmarks) {
+  Map2D<float> cost_map(/*width=*/20, /*height=*/10);
+  cost_map.fill(0.0);
+  LandmarkPlanner planner(cost_map, /*numLandmarks=*/2);
+
+  ASSERT_EQ(2, planner.getLandmarks().size());
+  const Cell first = planner.getLandmarks()[0];
+  const Cell second = planner.getLandmarks()[1];
+  EXPECT_EQ(19, std::abs(first.col - second.col));
+  EXPECT_EQ(9, std::abs(first.row - second.row));
+  EXPECT_EQ(2 * 20 * 10 * sizeof(double), planner.getMemoryBytes());
+}
+
+// Heuristic never exceeds the true remaining cost.
+TEST(LandmarkPlanner, admissible) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 100, 100, 100, 0.0,  //
+                         0.0, 0.0, 100, 0.0, 0.0,  //
+                         100, 0.0, 0.0, 0.0, 100,  //
+                         100, 0.0, INF, 0.0, 100,  //
+                         100, 0.0, 0.0, 0.0, 100});
+  LandmarkPlanner planner(cost_map, /*numLandmarks=*/3);
+
+  const Cell end(0, 4);
+  const DistanceField field = computeDistanceField(end, cost_map);
+  for (int row = 0; row < 5; ++row) {
+    for (int col = 0; col < 5; ++col) {
+      const Cell cell(row, col);
+      if (std::isinf(cost_map.getCost(cell))) {
+        continue;
+      }
+      // Costs are symmetric: cost from cell to end, minus cell's own cost.
+      EXPECT_LE(planner.heuristic(cell, end),
+                field.getCost(cell).cost - cost_map.getCost(cell) + 1e-9);
+    }
+  }
+}
+
+TEST(LandmarkPlanner, matchesComputePath) {
+  const int size = 40;
+  Map2D<float> cost_map(size, size);
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.25 ? INF : 3.0 * value;
+    }
+  }
+
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED}) {
+    LandmarkPlanner planner(cost_map, /*numLandmarks=*/6, mode);
+    for (int i = 0; i < 100; ++i) {
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+
+      std::vector<Cell> expected_path;
+      double expected_cost =
+          computePath(start, end, cost_map, expected_path, mode);
+
+      std::vector<Cell> path;
+      double path_cost = planner.computePath(start, end, path);
+      if (std::isinf(expected_cost)) {
+        EXPECT_EQ(INF, path_cost);
+        EXPECT_TRUE(path.empty());
+      } else {
+        EXPECT_NEAR(expected_cost, path_cost, 1e-9);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(start, path.front());
+        EXPECT_EQ(end, path.back());
+      }
+    }
+  }
+}
+
+TEST(LandmarkPlanner, fewerExpansions) {
+  Map2D<float> cost_map(/*width=*/64, /*height=*/64);
+  cost_map.fill(1.0);
+  const Cell start(40, 3);
+  const Cell end(20, 60);
+
+  PlannerStats dijkstra_stats;
+  std::vector<Cell> path;
+  double expected_cost = computePath(start, end, cost_map, path,
+                                     PlannerMode::FOUR_CONNECTED,
+                                     &dijkstra_stats);
+
+  LandmarkPlanner planner(cost_map, /*numLandmarks=*/4);
+  PlannerStats stats;
+  EXPECT_NEAR(expected_cost, planner.computePath(start, end, path, &stats),
+              1e-9);
+  EXPECT_LT(stats.expansions * 4, dijkstra_stats.expansions);
+}
@@ -0,0 +1,68 @@
+#include "map_2d.hh"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+
+template <typename LayoutT>
+void expectRoundTrip(int width, int height) {
+  std::vector<int> values;
+  for (int i = 0; i < width * height; ++i) {
+    values.push_back(i);
+  }
+
+  Map2D<int, LayoutT> map(width, height, values);
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      EXPECT_EQ(row * width + col, map.getCost(Cell(row, col)));
+    }
+  }
+}
+
+TEST(Map2D, rowMajor) { expectRoundTrip<RowMajorLayout>(7, 5); }
+
+// Map sizes that aren't a whole number of tiles.
+TEST(Map2D, tiled) {
+  expectRoundTrip<TiledLayout<> >(8, 8);
+  expectRoundTrip<TiledLayout<> >(13, 5);
+  expectRoundTrip<TiledLayout<2> >(1, 9);
+}
+
+TEST(TiledLayout, distinctIndices) {
+  const int width = 11, height = 6;
+  TiledLayout<2> layout(width, height);
+
+  std::set<int> indices;
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const int index = layout.index(row, col);
+      EXPECT_GE(index, 0);
+      EXPECT_LT(index, layout.size());
+      indices.insert(index);
+    }
+  }
+  EXPECT_EQ(width * height, indices.size());
+
+  // Cells in one tile are contiguous.
+  EXPECT_EQ(layout.index(0, 0) + 4, layout.index(1, 0));
+  EXPECT_EQ(16, layout.index(0, 4));
+}
+
+// Copies of a map over external storage own their values.
+TEST(Map2D, copyOfExternalIsDeep) {
+  std::shared_ptr<int> storage(new int[4]{1, 2, 3, 4},
+                               std::default_delete<int[]>());
+  Map2D<int> map(/*width=*/2, /*height=*/2, storage);
+
+  Map2D<int> copy(map);
+  copy.getCost(Cell(1, 1)) = 9;
+  EXPECT_EQ(4, map.getCost(Cell(1, 1)));
+  EXPECT_EQ(4, storage.get()[3]);
+  EXPECT_NE(map.data(), copy.data());
+
+  // Maps built from the same storage share it.
+  Map2D<int> shared(/*width=*/2, /*height=*/2, storage);
+  shared.getCost(Cell(0, 0)) = 7;
+  EXPECT_EQ(7, map.getCost(Cell(0, 0)));
+}
@@ -0,0 +1,105 @@
+#include "map_file.hh"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+namespace {
+
+/** Unique file path, removed at the end of the test. */
+struct TempPath {
+  TempPath()
+      : path(testing::TempDir() + "map_file_test_" +
+             std::to_string(getpid()) + "_" +
+             testing::UnitTest::GetInstance()->current_test_info()->name()) {}
+  ~TempPath() { std::remove(path.c_str()); }
+
+  const std::string path;
+};
+
+}  // namespace
+
+TEST(MapFile, roundTrip) {
+  Map2D<float> cost_map(/*width=*/4, /*height=*/3,
+                        // Values packed row major.
+                        {0.0, 1.0, 2.0, 3.0,  //
+                         4.0, INF, 6.0, 7.0,  //
+                         8.0, 9.0, 0.5, 0.0});
+  TempPath file;
+  ASSERT_TRUE(saveMapFile(file.path, cost_map));
+
+  std::optional<const Map2D<float> > loaded = loadMapFile(file.path);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(4, loaded->getWidth());
+  ASSERT_EQ(3, loaded->getHeight());
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      EXPECT_EQ(cost_map.getCost(Cell(row, col)),
+                loaded->getCost(Cell(row, col)));
+    }
+  }
+
+  std::vector<Cell> expected_path, path;
+  EXPECT_EQ(computePath(Cell(0, 0), Cell(2, 3), cost_map, expected_path),
+            computePath(Cell(0, 0), Cell(2, 3), *loaded, path));
+  EXPECT_EQ(expected_path, path);
+}
+
+// The loaded map is read-only; changes go to a copy, not the file.
+TEST(MapFile, copiesAreWritable) {
+  Map2D<float> cost_map(/*width=*/2, /*height=*/2);
+  cost_map.fill(1.0);
+  TempPath file;
+  ASSERT_TRUE(saveMapFile(file.path, cost_map));
+
+  std::optional<const Map2D<float> > loaded = loadMapFile(file.path);
+  ASSERT_TRUE(loaded);
+  Map2D<float> copy(*loaded);
+  copy.getCost(Cell(1, 1)) = 5.0;
+  EXPECT_EQ(5.0, copy.getCost(Cell(1, 1)));
+  EXPECT_EQ(1.0, loaded->getCost(Cell(1, 1)));
+
+  std::optional<const Map2D<float> > reloaded = loadMapFile(file.path);
+  ASSERT_TRUE(reloaded);
+  EXPECT_EQ(1.0, reloaded->getCost(Cell(1, 1)));
+}
+
+TEST(MapFile, invalidFiles) {
+  TempPath file;
+  EXPECT_FALSE(loadMapFile(file.path));  // Missing.
+
+  FILE *out = std::fopen(file.path.c_str(), "wb");
+  ASSERT_NE(nullptr, out);
+  std::fputs("not a map file, but long enough for a header", out);
+  std::fclose(out);
+  EXPECT_FALSE(loadMapFile(file.path));
+
+  // Truncated values.
+  Map2D<float> cost_map(/*width=*/3, /*height=*/3);
+  ASSERT_TRUE(saveMapFile(file.path, cost_map));
+  ASSERT_EQ(0, truncate(file.path.c_str(), 32 + 4 * sizeof(float)));
+  EXPECT_FALSE(loadMapFile(file.path));
+
+  // More cells than Map2D can index, with a matching (sparse) file size.
+  const int32_t side = 46341;  // side * side > INT_MAX
+  ASSERT_TRUE(saveMapFile(file.path, cost_map));
+  out = std::fopen(file.path.c_str(), "r+b");
+  ASSERT_NE(nullptr, out);
+  std::fseek(out, 12, SEEK_SET);  // width, then height
+  std::fwrite(&side, sizeof(side), 1, out);
+  std::fwrite(&side, sizeof(side), 1, out);
+  std::fclose(out);
+  ASSERT_EQ(0, truncate(file.path.c_str(),
+                        32 + sizeof(float) * (off_t)side * side));
+  EXPECT_FALSE(loadMapFile(file.path));
+}
@@ -0,0 +1,109 @@
+#include "path_simplifier.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(compressCollinear, keepsTurns) {
+  const std::vector<Cell> path = {Cell(0, 0), Cell(0, 1), Cell(0, 2),
+                                  Cell(1, 2), Cell(2, 2), Cell(3, 3),
+                                  Cell(4, 4)};
+  EXPECT_EQ(std::vector<Cell>({Cell(0, 0), Cell(0, 2), Cell(2, 2),
+                               Cell(4, 4)}),
+            compressCollinear(path));
+
+  EXPECT_TRUE(compressCollinear({}).empty());
+  EXPECT_EQ(std::vector<Cell>({Cell(1, 1)}), compressCollinear({Cell(1, 1)}));
+}
+
+// A U-turn isn't a straight run, even though the cells line up.
+TEST(compressCollinear, keepsReversals) {
+  const std::vector<Cell> path = {Cell(0, 0), Cell(0, 1), Cell(0, 0)};
+  EXPECT_EQ(path, compressCollinear(path));
+}
+
+// With no cell costs, the straight line is cheapest. (Otherwise it may not
+// be: a line crosses more cells than a diagonal staircase enters.)
+TEST(simplifyPath, openField) {
+  Map2D<float> cost_map(/*width=*/40, /*height=*/30);
+  cost_map.fill(0.0);
+
+  std::vector<Cell> path;
+  const double path_cost = computePath(Cell(2, 1), Cell(27, 38), cost_map,
+                                       path, PlannerMode::EIGHT_CONNECTED);
+
+  std::vector<Cell> waypoints;
+  const double cost = simplifyPath(path, cost_map, 0.0, waypoints);
+  EXPECT_EQ(std::vector<Cell>({Cell(2, 1), Cell(27, 38)}), waypoints);
+  EXPECT_LT(cost, path_cost);
+}
+
+TEST(simplifyPath, avoidsObstacles) {
+  Map2D<float> cost_map(/*width=*/5, /*height=*/5,
+                        // Values packed row major.
+                        {0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         INF, INF, INF, 0.0, INF,  // obstacle!
+                         0.0, 0.0, 0.0, 0.0, 0.0,  //
+                         0.0, 0.0, 0.0, 0.0, 0.0});
+
+  std::vector<Cell> path;
+  computePath(Cell(0, 0), Cell(4, 0), cost_map, path);
+
+  std::vector<Cell> waypoints;
+  const double cost = simplifyPath(path, cost_map, 0.0, waypoints);
+  ASSERT_GE(waypoints.size(), 3);
+  for (size_t i = 1; i < waypoints.size(); ++i) {
+    EXPECT_FALSE(
+        std::isinf(impl::lineCost(cost_map, waypoints[i - 1], waypoints[i])));
+  }
+  EXPECT_FALSE(std::isinf(cost));
+}
+
+// Weighted maps: the cost never grows by more than the allowed fraction.
+TEST(simplifyPath, boundedCostIncrease) {
+  const int size = 40;
+  Map2D<float> cost_map(size, size);
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.15 ? INF : 4.0 * value;
+    }
+  }
+
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  for (double max_increase : {0.0, 0.1, 0.5}) {
+    for (int i = 0; i < 30; ++i) {
+      std::vector<Cell> path;
+      const Cell start(coord(rng), coord(rng));
+      const Cell end(coord(rng), coord(rng));
+      const double path_cost = computePath(start, end, cost_map, path,
+                                           PlannerMode::EIGHT_CONNECTED);
+      if (std::isinf(path_cost)) {
+        continue;
+      }
+
+      std::vector<Cell> waypoints;
+      const double cost =
+          simplifyPath(path, cost_map, max_increase, waypoints);
+      EXPECT_EQ(path.front(), waypoints.front());
+      EXPECT_EQ(path.back(), waypoints.back());
+      EXPECT_LE(waypoints.size(), path.size());
+      EXPECT_LE(cost, (1.0 + max_increase) * path_cost + 1e-9);
+
+      double total = cost_map.getCost(waypoints[0]);
+      for (size_t j = 1; j < waypoints.size(); ++j) {
+        total += impl::lineCost(cost_map, waypoints[j - 1], waypoints[j]);
+      }
+      EXPECT_NEAR(cost, total, 1e-9);
+    }
+  }
+}
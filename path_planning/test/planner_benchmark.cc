@@ -0,0 +1,669 @@
+// Planner benchmarks. Prints one line per measurement.
+//
+// Usage: planner_benchmark [map_size]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "coarse_to_fine_planner.hh"
+#include "djikstra_planner.hh"
+#include "dstar_lite_planner.hh"
+#include "hierarchical_planner.hh"
+#include "jump_point_planner.hh"
+#include "landmark_planner.hh"
+#include "map_2d.hh"
+#include "map_file.hh"
+#include "planner_stats.hh"
+#include "path_simplifier.hh"
+#include "planning_service.hh"
+
+namespace {
+
+/** Returns average wall time of fn, in milliseconds. */
+double timeMs(std::function<void()> const &fn, int repeats = 3) {
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count() /
+         repeats;
+}
+
+/** Uniform cost map with a fraction of cells blocked. */
+Map2D<float> makeOpenField(int size, float obstacle_fraction) {
+  Map2D<float> cost_map(size, size);
+  cost_map.fill(1.0);
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      if (uniform(rng) < obstacle_fraction) {
+        cost_map.getCost(Cell(row, col)) =
+            std::numeric_limits<float>::infinity();
+      }
+    }
+  }
+
+  cost_map.getCost(Cell(0, 0)) = 1.0;
+  cost_map.getCost(Cell(size - 1, size - 1)) = 1.0;
+  return cost_map;
+}
+
+/** JPS vs plain A*, corner to corner. */
+void benchmarkJumpPoint(const char *name, Map2D<float> const &cost_map) {
+  const Cell start(0, 0);
+  const Cell end(cost_map.getHeight() - 1, cost_map.getWidth() - 1);
+
+  const float min_cost = minCellCost(cost_map);
+  PlannerScratch scratch(cost_map.getWidth(), cost_map.getHeight());
+
+  std::vector<Cell> path;
+  PlannerStats astar_stats;
+  double astar_ms = timeMs([&] {
+    astar_stats = PlannerStats();
+    impl::computeAStarPath(start, end, cost_map, path, min_cost, scratch,
+                           &astar_stats);
+  });
+
+  PlannerStats jps_stats;
+  double jps_ms = timeMs([&] {
+    jps_stats = PlannerStats();
+    computeJumpPointPath(start, end, cost_map, path, min_cost, scratch,
+                         &jps_stats);
+  });
+
+  printf("%-24s A*:  %8zu pushes %8zu pops %9.2f ms\n", name,
+         astar_stats.heap_pushes, astar_stats.heap_pops, astar_ms);
+  printf("%-24s JPS: %8zu pushes %8zu pops %9.2f ms\n", name,
+         jps_stats.heap_pushes, jps_stats.heap_pops, jps_ms);
+}
+
+/** Uniform cost map with random weighted patches and walls. */
+Map2D<float> makeWeightedField(int size) {
+  Map2D<float> cost_map(size, size);
+  cost_map.fill(0.5);
+
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  std::uniform_int_distribution<int> patch_size(1, 32);
+  std::uniform_real_distribution<float> patch_cost(0.0, 5.0);
+  std::uniform_int_distribution<int> obstacle(0, 3);
+  for (int patch = 0; patch < size / 2; ++patch) {
+    const int row = coord(rng);
+    const int col = coord(rng);
+    const bool is_wall = obstacle(rng) == 0;
+    const int height = is_wall ? 1 : patch_size(rng);
+    const float value =
+        is_wall ? std::numeric_limits<float>::infinity() : patch_cost(rng);
+    for (int r = row; r < std::min(size, row + height); ++r) {
+      for (int c = col; c < std::min(size, col + patch_size(rng)); ++c) {
+        cost_map.getCost(Cell(r, c)) = value;
+      }
+    }
+  }
+  return cost_map;
+}
+
+/** Random start/end pairs on open cells. */
+std::vector<std::pair<Cell, Cell> > makeQueries(Map2D<float> const &cost_map,
+                                                int num_queries) {
+  std::mt19937 rng(99);
+  std::uniform_int_distribution<int> row(0, cost_map.getHeight() - 1);
+  std::uniform_int_distribution<int> col(0, cost_map.getWidth() - 1);
+
+  std::vector<std::pair<Cell, Cell> > queries;
+  while ((int)queries.size() < num_queries) {
+    const Cell start(row(rng), col(rng));
+    const Cell end(row(rng), col(rng));
+    if (!std::isinf(cost_map.getCost(start)) &&
+        !std::isinf(cost_map.getCost(end))) {
+      queries.push_back({start, end});
+    }
+  }
+  return queries;
+}
+
+/** HPA* query latency and optimality gap vs computePath. */
+void benchmarkHierarchical(int size, int cluster_size, int entrance_spacing) {
+  Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 20);
+
+  std::optional<HierarchicalPlanner> planner;
+  double build_ms = timeMs(
+      [&] { planner.emplace(cost_map, cluster_size, entrance_spacing); },
+      /*repeats=*/1);
+
+  std::vector<Cell> path;
+  std::vector<double> expected_costs;
+  double full_ms = timeMs(
+      [&] {
+        for (const auto &query : queries) {
+          path.clear();
+          expected_costs.push_back(
+              computePath(query.first, query.second, cost_map, path));
+        }
+      },
+      /*repeats=*/1);
+
+  std::vector<double> costs;
+  HierarchicalPlanner::Scratch scratch(*planner);
+  double hpa_ms = timeMs(
+      [&] {
+        for (const auto &query : queries) {
+          costs.push_back(
+              planner->computePath(query.first, query.second, path, scratch));
+        }
+      },
+      /*repeats=*/1);
+
+  double worst_gap = 0.0, total_gap = 0.0;
+  int num_feasible = 0;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if (std::isinf(expected_costs[i])) {
+      continue;
+    }
+    const double gap = costs[i] / expected_costs[i] - 1.0;
+    worst_gap = std::max(worst_gap, gap);
+    total_gap += gap;
+    ++num_feasible;
+  }
+
+  // Rebuild after a small patch of cost changes.
+  std::vector<Cell> changed;
+  for (int r = size / 2; r < size / 2 + 4; ++r) {
+    for (int c = size / 2; c < size / 2 + 4; ++c) {
+      cost_map.getCost(Cell(r, c)) += 1.0;
+      changed.push_back(Cell(r, c));
+    }
+  }
+  int rebuilt = 0;
+  double update_ms =
+      timeMs([&] { rebuilt = planner->updateCells(changed); }, /*repeats=*/1);
+
+  printf("HPA* %dx%d cluster %d spacing %d: %d clusters, %d entrances, "
+         "build %.1f ms\n",
+         size, size, cluster_size, entrance_spacing,
+         planner->getNumClusters(), planner->getNumEntrances(), build_ms);
+  printf("  computePath %.2f ms/query, HPA* %.2f ms/query, gap mean %.2f%% "
+         "worst %.2f%%\n",
+         full_ms / queries.size(), hpa_ms / queries.size(),
+         100.0 * total_gap / std::max(1, num_feasible), 100.0 * worst_gap);
+  printf("  update 16 cells: %d clusters rebuilt in %.2f ms\n", rebuilt,
+         update_ms);
+}
+
+/** Coarse-to-fine query latency and optimality gap vs computePath. */
+void benchmarkCoarseToFine(int size) {
+  const Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 10);
+
+  std::vector<Cell> path;
+  std::vector<double> expected_costs;
+  double full_ms = timeMs(
+      [&] {
+        for (const auto &query : queries) {
+          expected_costs.push_back(
+              computePath(query.first, query.second, cost_map, path));
+        }
+      },
+      /*repeats=*/1);
+  printf("Coarse-to-fine %dx%d: computePath %.2f ms/query\n", size, size,
+         full_ms / queries.size());
+
+  for (int levels : {2, 3, 4}) {
+    for (Pooling pooling : {Pooling::MAX, Pooling::MEAN}) {
+      std::optional<CoarseToFinePlanner> planner;
+      double build_ms = timeMs(
+          [&] { planner.emplace(cost_map, levels, pooling); }, /*repeats=*/1);
+
+      std::vector<double> costs;
+      double query_ms = timeMs(
+          [&] {
+            for (const auto &query : queries) {
+              costs.push_back(
+                  planner->computePath(query.first, query.second, path));
+            }
+          },
+          /*repeats=*/1);
+
+      double worst_gap = 0.0, total_gap = 0.0;
+      int num_feasible = 0;
+      for (size_t i = 0; i < queries.size(); ++i) {
+        if (std::isinf(expected_costs[i])) {
+          continue;
+        }
+        const double gap = costs[i] / expected_costs[i] - 1.0;
+        worst_gap = std::max(worst_gap, gap);
+        total_gap += gap;
+        ++num_feasible;
+      }
+      printf("  %d levels %s pooling: build %.1f ms, %.2f ms/query, gap mean "
+             "%.2f%% worst %.2f%%\n",
+             levels, pooling == Pooling::MAX ? "max" : "mean", build_ms,
+             query_ms / queries.size(),
+             100.0 * total_gap / std::max(1, num_feasible), 100.0 * worst_gap);
+    }
+  }
+}
+
+/** ALT build time, memory and query latency vs landmark count. */
+void benchmarkLandmarks(int size) {
+  const Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 20);
+
+  std::vector<Cell> path;
+  PlannerStats dijkstra_stats;
+  double dijkstra_ms = timeMs(
+      [&] {
+        for (const auto &query : queries) {
+          computePath(query.first, query.second, cost_map, path,
+                      PlannerMode::FOUR_CONNECTED, &dijkstra_stats);
+        }
+      },
+      /*repeats=*/1);
+  printf("ALT %dx%d: computePath %.2f ms/query, %zu expansions\n", size, size,
+         dijkstra_ms / queries.size(),
+         dijkstra_stats.expansions / queries.size());
+
+  for (int num_landmarks : {1, 2, 4, 8, 16}) {
+    std::optional<LandmarkPlanner> planner;
+    double build_ms = timeMs([&] { planner.emplace(cost_map, num_landmarks); },
+                             /*repeats=*/1);
+
+    PlannerStats stats;
+    double query_ms = timeMs(
+        [&] {
+          for (const auto &query : queries) {
+            planner->computePath(query.first, query.second, path, &stats);
+          }
+        },
+        /*repeats=*/1);
+    printf("  %2d landmarks: build %.0f ms, %.1f MB, %.2f ms/query, "
+           "%zu expansions\n",
+           num_landmarks, build_ms, planner->getMemoryBytes() / 1048576.0,
+           query_ms / queries.size(), stats.expansions / queries.size());
+  }
+}
+
+/** Path size and cost before/after simplifyPath. */
+void benchmarkSimplify(int size) {
+  const Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 10);
+
+  std::vector<std::vector<Cell> > paths;
+  std::vector<double> path_costs;
+  size_t num_cells = 0;
+  for (const auto &query : queries) {
+    paths.emplace_back();
+    path_costs.push_back(computePath(query.first, query.second, cost_map,
+                                     paths.back(),
+                                     PlannerMode::EIGHT_CONNECTED));
+    num_cells += paths.back().size();
+  }
+
+  size_t num_collinear = 0;
+  for (const auto &path : paths) {
+    num_collinear += compressCollinear(path).size();
+  }
+  printf("Simplify %dx%d: %zu cells (%zu bytes), %zu after compressCollinear\n",
+         size, size, num_cells, num_cells * sizeof(Cell), num_collinear);
+
+  for (double max_increase : {0.0, 0.01, 0.1}) {
+    size_t num_waypoints = 0;
+    double worst_increase = 0.0;
+    std::vector<Cell> waypoints;
+    double ms = timeMs(
+        [&] {
+          for (size_t i = 0; i < paths.size(); ++i) {
+            if (paths[i].empty()) {
+              continue;
+            }
+            const double cost =
+                simplifyPath(paths[i], cost_map, max_increase, waypoints);
+            num_waypoints += waypoints.size();
+            worst_increase =
+                std::max(worst_increase, cost / path_costs[i] - 1.0);
+          }
+        },
+        /*repeats=*/1);
+    printf("  max increase %.0f%%: %zu waypoints (%zu bytes), worst increase "
+           "%.2f%%, %.2f ms/path\n",
+           100.0 * max_increase, num_waypoints, num_waypoints * sizeof(Cell),
+           100.0 * worst_increase, ms / paths.size());
+  }
+}
+
+/** D* Lite repair latency vs computePath after new obstacles on the path. */
+void benchmarkIncremental(int size) {
+  Map2D<float> cost_map = makeWeightedField(size);
+  const auto query = makeQueries(cost_map, 1).front();
+
+  std::optional<DStarLitePlanner> planner;
+  std::vector<Cell> path;
+  PlannerStats initial_stats;
+  double initial_ms = timeMs(
+      [&] {
+        planner.emplace(cost_map, query.first, query.second);
+        planner->computePath(path, &initial_stats);
+      },
+      /*repeats=*/1);
+
+  const int num_rounds = 10;
+  double repair_ms = 0.0, full_ms = 0.0;
+  size_t repair_expansions = 0;
+  for (int round = 0; round < num_rounds && path.size() > 4; ++round) {
+    // Drop a small obstacle on the current path, away from start and end.
+    const Cell center = path[path.size() / 2];
+    for (int r = center.row - 1; r <= center.row + 1; ++r) {
+      for (int c = center.col - 1; c <= center.col + 1; ++c) {
+        const Cell cell(r, c);
+        if (r < 0 || r >= size || c < 0 || c >= size || cell == query.first ||
+            cell == query.second) {
+          continue;
+        }
+        cost_map.getCost(cell) = std::numeric_limits<float>::infinity();
+        planner->updateCell(cell, cost_map.getCost(cell));
+      }
+    }
+
+    PlannerStats stats;
+    repair_ms += timeMs([&] { planner->computePath(path, &stats); },
+                        /*repeats=*/1);
+    repair_expansions += stats.expansions;
+
+    std::vector<Cell> full_path;
+    full_ms += timeMs(
+        [&] { computePath(query.first, query.second, cost_map, full_path); },
+        /*repeats=*/1);
+  }
+
+  printf("D* Lite %dx%d: initial %.2f ms (%zu expansions)\n", size, size,
+         initial_ms, initial_stats.expansions);
+  printf("  replan: D* Lite %.2f ms (%zu expansions), computePath %.2f ms\n",
+         repair_ms / num_rounds, repair_expansions / num_rounds,
+         full_ms / num_rounds);
+}
+
+/** One source to many goals: computePath per goal vs one shared expansion. */
+void benchmarkDistanceField(int size) {
+  Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 32);
+  const Cell start = queries.front().first;
+  std::vector<Cell> ends;
+  for (const auto &query : queries) {
+    ends.push_back(query.second);
+  }
+
+  std::vector<Cell> path;
+  double per_goal_ms = timeMs(
+      [&] {
+        for (const Cell end : ends) {
+          computePath(start, end, cost_map, path);
+        }
+      },
+      /*repeats=*/1);
+
+  double batched_ms =
+      timeMs([&] { computeCosts(start, ends, cost_map); }, /*repeats=*/1);
+  double field_ms =
+      timeMs([&] { computeDistanceField(start, cost_map); }, /*repeats=*/1);
+
+  printf("1 -> %zu goals %dx%d: computePath each %.2f ms, computeCosts "
+         "%.2f ms, full field %.2f ms\n",
+         ends.size(), size, size, per_goal_ms, batched_ms, field_ms);
+}
+
+/** computePath throughput on long queries, in each mode. */
+void benchmarkComputePath(int size) {
+  const Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 8);
+
+  for (PlannerMode mode :
+       {PlannerMode::FOUR_CONNECTED, PlannerMode::EIGHT_CONNECTED}) {
+    PlannerScratch scratch(size, size);
+    std::vector<Cell> path;
+    PlannerStats stats;
+    double ms = timeMs(
+        [&] {
+          for (const auto &query : queries) {
+            // computePath appends to path.
+            path.clear();
+            computePath(query.first, query.second, cost_map, path, mode,
+                        scratch, &stats);
+          }
+        },
+        /*repeats=*/1);
+
+    PlannerStats bidirectional_stats;
+    double bidirectional_ms = timeMs(
+        [&] {
+          for (const auto &query : queries) {
+            computeBidirectionalPath(query.first, query.second, cost_map,
+                                     path, mode, &bidirectional_stats);
+          }
+        },
+        /*repeats=*/1);
+
+    printf("computePath %dx%d %s: %.2f ms/query, %zu expansions; "
+           "bidirectional %.2f ms/query, %zu expansions\n",
+           size, size,
+           mode == PlannerMode::FOUR_CONNECTED ? "4-connected" : "8-connected",
+           ms / queries.size(), stats.expansions / queries.size(),
+           bidirectional_ms / queries.size(),
+           bidirectional_stats.expansions / queries.size());
+  }
+}
+
+/** PlanningService throughput from 1 worker up to one per core. */
+void benchmarkPlanningService(int size) {
+  Map2D<float> cost_map = makeWeightedField(size);
+  std::vector<PathQuery> queries;
+  for (const auto &query : makeQueries(cost_map, 64)) {
+    queries.push_back(PathQuery(query.first, query.second));
+  }
+
+  std::vector<Cell> path;
+  double sequential_ms = timeMs(
+      [&] {
+        for (const auto &query : queries) {
+          computePath(query.start, query.end, cost_map, path);
+        }
+      },
+      /*repeats=*/1);
+  printf("%zu queries %dx%d: computePath each %.1f ms (%.0f queries/s)\n",
+         queries.size(), size, size, sequential_ms,
+         1000.0 * queries.size() / sequential_ms);
+
+  const int max_workers = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<int> worker_counts;
+  for (int workers = 1; workers < max_workers; workers *= 2) {
+    worker_counts.push_back(workers);
+  }
+  worker_counts.push_back(max_workers);
+
+  for (const int workers : worker_counts) {
+    PlanningService service(cost_map, workers);
+    double service_ms =
+        timeMs([&] { service.computePaths(queries); }, /*repeats=*/1);
+    printf("  PlanningService %2d workers: %.1f ms (%.0f queries/s, %.2fx)\n",
+           workers, service_ms, 1000.0 * queries.size() / service_ms,
+           sequential_ms / service_ms);
+  }
+}
+
+/**
+ * Hardware cache-miss counter for the calling thread. Reads -1 when perf
+ * events are unavailable (not Linux, or perf_event_paranoid forbids it).
+ */
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  long long stop() {
+    long long count = -1;
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+        count = -1;
+      }
+    }
+#endif
+    return count;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+template <typename LayoutT>
+void benchmarkLayout(const char *name, Map2D<float> const &row_major,
+                     std::vector<std::pair<Cell, Cell> > const &queries) {
+  const int width = row_major.getWidth(), height = row_major.getHeight();
+  Map2D<float, LayoutT> cost_map(width, height);
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      cost_map.getCost(Cell(row, col)) = row_major.getCost(Cell(row, col));
+    }
+  }
+  BasicPlannerScratch<LayoutT> scratch(width, height);
+
+  CacheMissCounter counter;
+  double total = 0.0;
+  long long misses = 0;
+  double ms = timeMs(
+      [&] {
+        std::vector<Cell> path;
+        total = 0.0;
+        counter.start();
+        for (const auto &query : queries) {
+          path.clear();
+          total += computePath(query.first, query.second, cost_map, path,
+                               PlannerMode::FOUR_CONNECTED, scratch);
+        }
+        misses = counter.stop();
+      },
+      /*repeats=*/1);
+
+  printf("  %-10s %9.2f ms/query, %10lld cache misses (checksum %.6g)\n",
+         name, ms / queries.size(), misses, total);
+}
+
+/** computePath on long queries with each layout the planner is built for. */
+void benchmarkLayouts(int size) {
+  const Map2D<float> cost_map = makeWeightedField(size);
+  const auto queries = makeQueries(cost_map, 8);
+  printf("Layouts, computePath %dx%d (-1: no perf counters):\n", size, size);
+  benchmarkLayout<RowMajorLayout>("row major", cost_map, queries);
+  benchmarkLayout<TiledLayout<> >("8x8 tiles", cost_map, queries);
+}
+
+/** Map startup: reading a map file into memory vs loadMapFile. */
+void benchmarkMapFile(int size) {
+  const std::string path = "/tmp/planner_benchmark_map.bin";
+  Map2D<float> cost_map(size, size);
+  cost_map.fill(1.0);
+  if (!saveMapFile(path, cost_map)) {
+    printf("Map file: can't write %s\n", path.c_str());
+    return;
+  }
+
+  double copy_ms = timeMs(
+      [&] {
+        Map2D<float> copy(size, size);
+        FILE *file = fopen(path.c_str(), "rb");
+        fseek(file, 32, SEEK_SET);
+        if (fread(&copy.getCost(Cell(0, 0)), sizeof(float), copy.size(),
+                  file) != (size_t)copy.size()) {
+          printf("Map file: short read\n");
+        }
+        fclose(file);
+      },
+      /*repeats=*/1);
+  double mmap_ms = timeMs([&] { loadMapFile(path); }, /*repeats=*/1);
+
+  printf("Map file %dx%d (%.0f MB): read %.2f ms, loadMapFile %.3f ms\n",
+         size, size, sizeof(float) * size * (double)size / (1 << 20), copy_ms,
+         mmap_ms);
+  remove(path.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int size = argc > 1 ? std::atoi(argv[1]) : 512;
+
+  benchmarkJumpPoint("open field", makeOpenField(size, 0.0));
+  benchmarkJumpPoint("open field, 5% blocked", makeOpenField(size, 0.05));
+
+  benchmarkHierarchical(size, /*cluster_size=*/16, /*entrance_spacing=*/0);
+  benchmarkHierarchical(size, /*cluster_size=*/16, /*entrance_spacing=*/4);
+
+  benchmarkCoarseToFine(2 * size);
+
+  benchmarkLandmarks(size);
+
+  benchmarkSimplify(size);
+
+  benchmarkIncremental(size);
+
+  benchmarkDistanceField(size);
+
+  benchmarkComputePath(size);
+
+  benchmarkPlanningService(size);
+
+  benchmarkLayouts(4 * size);
+
+  benchmarkMapFile(16 * size);
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "planning_service.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "djikstra_planner.hh"
+#include "map_2d.hh"
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+TEST(PlanningService, emptyBatch) {
+  Map2D<float> cost_map(/*width=*/1, /*height=*/1);
+  PlanningService service(cost_map, /*numWorkers=*/4);
+
+  EXPECT_EQ(4, service.getNumWorkers());
+  EXPECT_TRUE(service.computePaths({}).empty());
+}
+
+TEST(PlanningService, matchesComputePath) {
+  const int size = 32;
+  Map2D<float> cost_map(size, size);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const float value = uniform(rng);
+      cost_map.getCost(Cell(row, col)) = value < 0.2 ? INF : 2.0 * value;
+    }
+  }
+
+  // Includes infeasible starts and ends.
+  std::uniform_int_distribution<int> coord(0, size - 1);
+  const PlannerMode modes[] = {PlannerMode::FOUR_CONNECTED,
+                               PlannerMode::EIGHT_CONNECTED,
+                               PlannerMode::ANY_ANGLE};
+  std::vector<PathQuery> queries;
+  for (int i = 0; i < 60; ++i) {
+    queries.push_back(PathQuery(Cell(coord(rng), coord(rng)),
+                                Cell(coord(rng), coord(rng)), modes[i % 3]));
+  }
+
+  for (int num_workers : {1, 3}) {
+    PlanningService service(cost_map, num_workers);
+    // Second batch reuses each worker's scratch.
+    for (int batch = 0; batch < 2; ++batch) {
+      const std::vector<PathResult> results = service.computePaths(queries);
+
+      ASSERT_EQ(queries.size(), results.size());
+      for (size_t i = 0; i < queries.size(); ++i) {
+        std::vector<Cell> expected_path;
+        double expected_cost =
+            computePath(queries[i].start, queries[i].end, cost_map,
+                        expected_path, queries[i].mode);
+        EXPECT_EQ(expected_cost, results[i].cost);
+        EXPECT_EQ(expected_path, results[i].path);
+      }
+    }
+  }
+}